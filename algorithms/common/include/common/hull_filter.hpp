@@ -0,0 +1,72 @@
+#pragma once
+#include <cmath>
+
+#include "common/predicates.hpp"
+
+namespace common {
+
+// Akl-Toussaint throw-away region. The extreme points in the x, y, x+y and
+// x-y directions span an octagon, and no point strictly inside it can be a
+// hull vertex. inside() only answers true when the floating-point filter of
+// orient2d proves it, so ambiguous points are kept rather than dropped.
+class ExtremeOctagon {
+public:
+    void add(double x, double y) {
+        const double key[8] = {-x, -(x + y), -y, x - y, x, x + y, y, y - x};
+        for (int k = 0; k < 8; ++k) {
+            if (empty_ || key[k] > best_[k]) {
+                best_[k] = key[k];
+                px_[k] = x;
+                py_[k] = y;
+            }
+        }
+        empty_ = false;
+    }
+
+    void merge(const ExtremeOctagon& other) {
+        if (other.empty_) return;
+        for (int k = 0; k < 8; ++k) {
+            if (empty_ || other.best_[k] > best_[k]) {
+                best_[k] = other.best_[k];
+                px_[k] = other.px_[k];
+                py_[k] = other.py_[k];
+            }
+        }
+        empty_ = false;
+    }
+
+    void close() {
+        count_ = 0;
+        if (empty_) return;
+        for (int k = 0; k < 8; ++k) {
+            if (count_ > 0 && px_[k] == vx_[count_-1] && py_[k] == vy_[count_-1]) continue;
+            vx_[count_] = px_[k];
+            vy_[count_] = py_[k];
+            ++count_;
+        }
+        while (count_ > 1 && vx_[0] == vx_[count_-1] && vy_[0] == vy_[count_-1]) --count_;
+        if (count_ < 3) count_ = 0;
+    }
+
+    bool inside(double x, double y) const {
+        if (count_ == 0) return false;
+        for (int k = 0; k < count_; ++k) {
+            const int j = k + 1 == count_ ? 0 : k + 1;
+            const double l = (vx_[k] - x) * (vy_[j] - y);
+            const double r = (vy_[k] - y) * (vx_[j] - x);
+            if (!(l - r > detail::kOrientBound * (std::fabs(l) + std::fabs(r)))) return false;
+        }
+        return true;
+    }
+
+private:
+    bool empty_ = true;
+    double best_[8] = {};
+    double px_[8] = {};
+    double py_[8] = {};
+    double vx_[8] = {};
+    double vy_[8] = {};
+    int count_ = 0;
+};
+
+} 
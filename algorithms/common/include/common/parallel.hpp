@@ -0,0 +1,40 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace common {
+
+inline int resolve_threads(int requested) {
+    if (requested > 0) return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+// Runs body(index, worker) for every index in [0, count) on up to `threads`
+// workers (0 = hardware concurrency). Worker ids are dense in [0, threads),
+// so callers can keep per-worker scratch without locking.
+template <class Body>
+void parallel_for(size_t count, int threads, Body&& body) {
+    const size_t workers = std::min(count, static_cast<size_t>(resolve_threads(threads)));
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) body(i, 0);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto run = [&](int worker) {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i, worker);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) pool.emplace_back(run, static_cast<int>(w));
+    run(0);
+    for (auto& t : pool) t.join();
+}
+
+} 
@@ -0,0 +1,107 @@
+#pragma once
+#include <cmath>
+#include <type_traits>
+
+namespace common {
+
+namespace detail {
+constexpr double kEpsilon = 1.1102230246251565e-16;
+constexpr double kOrientBound = (3.0 + 16.0 * kEpsilon) * kEpsilon;
+constexpr double kIncircleBound = (10.0 + 96.0 * kEpsilon) * kEpsilon;
+}
+
+double orient2d_adapt(double ax, double ay, double bx, double by,
+                      double cx, double cy, double detsum);
+
+double cross2d_adapt(double ax, double ay, double bx, double by,
+                     double cx, double cy, double dx, double dy, double detsum);
+
+double incircle_adapt(double ax, double ay, double bx, double by,
+                      double cx, double cy, double dx, double dy);
+
+// Positive when a, b, c turn counter-clockwise, negative when clockwise and
+// exactly zero when collinear. Only the sign is exact.
+inline double orient2d(double ax, double ay, double bx, double by,
+                       double cx, double cy)
+{
+    const double detleft = (ax - cx) * (by - cy);
+    const double detright = (ay - cy) * (bx - cx);
+    const double det = detleft - detright;
+    const double detsum = std::fabs(detleft) + std::fabs(detright);
+    if (std::fabs(det) >= detail::kOrientBound * detsum) return det;
+    return orient2d_adapt(ax, ay, bx, by, cx, cy, detsum);
+}
+
+// Cross product of the directions b - a and d - c: positive when d - c
+// turns counter-clockwise from b - a, negative when clockwise and exactly
+// zero when they are parallel. Only the sign is exact.
+inline double cross2d(double ax, double ay, double bx, double by,
+                      double cx, double cy, double dx, double dy)
+{
+    const double detleft = (bx - ax) * (dy - cy);
+    const double detright = (by - ay) * (dx - cx);
+    const double det = detleft - detright;
+    const double detsum = std::fabs(detleft) + std::fabs(detright);
+    if (std::fabs(det) >= detail::kOrientBound * detsum) return det;
+    return cross2d_adapt(ax, ay, bx, by, cx, cy, dx, dy, detsum);
+}
+
+// Positive when d lies inside the circle through the counter-clockwise
+// triangle a, b, c, negative outside and exactly zero when cocircular.
+inline double incircle(double ax, double ay, double bx, double by,
+                       double cx, double cy, double dx, double dy)
+{
+    const double adx = ax - dx, ady = ay - dy;
+    const double bdx = bx - dx, bdy = by - dy;
+    const double cdx = cx - dx, cdy = cy - dy;
+
+    const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady, adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy, bdxady = bdx * ady;
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+
+    const double det = alift * (bdxcdy - cdxbdy)
+                     + blift * (cdxady - adxcdy)
+                     + clift * (adxbdy - bdxady);
+    const double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift
+                           + (std::fabs(cdxady) + std::fabs(adxcdy)) * blift
+                           + (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    if (std::fabs(det) > detail::kIncircleBound * permanent) return det;
+    return incircle_adapt(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+// Point forms. They take double coordinates only, so a wider point type
+// cannot be rounded here behind the caller's back; callers holding long
+// double coordinates narrow explicitly and say why that is safe.
+template <class P>
+inline double orient2d(const P& a, const P& b, const P& c) {
+    static_assert(std::is_same<decltype(a.x), double>::value,
+                  "orient2d takes double coordinates; narrow explicitly");
+    return orient2d(static_cast<double>(a.x), static_cast<double>(a.y),
+                    static_cast<double>(b.x), static_cast<double>(b.y),
+                    static_cast<double>(c.x), static_cast<double>(c.y));
+}
+
+template <class P>
+inline double cross2d(const P& a, const P& b, const P& c, const P& d) {
+    static_assert(std::is_same<decltype(a.x), double>::value,
+                  "cross2d takes double coordinates; narrow explicitly");
+    return cross2d(static_cast<double>(a.x), static_cast<double>(a.y),
+                   static_cast<double>(b.x), static_cast<double>(b.y),
+                   static_cast<double>(c.x), static_cast<double>(c.y),
+                   static_cast<double>(d.x), static_cast<double>(d.y));
+}
+
+template <class P>
+inline double incircle(const P& a, const P& b, const P& c, const P& d) {
+    static_assert(std::is_same<decltype(a.x), double>::value,
+                  "incircle takes double coordinates; narrow explicitly");
+    return incircle(static_cast<double>(a.x), static_cast<double>(a.y),
+                    static_cast<double>(b.x), static_cast<double>(b.y),
+                    static_cast<double>(c.x), static_cast<double>(c.y),
+                    static_cast<double>(d.x), static_cast<double>(d.y));
+}
+
+} 
@@ -0,0 +1,270 @@
+#include "common/predicates.hpp"
+
+namespace common {
+namespace {
+constexpr double kSplitter = 134217729.0;
+constexpr double kResultBound = (3.0 + 8.0 * detail::kEpsilon) * detail::kEpsilon;
+constexpr double kOrientBoundB = (2.0 + 12.0 * detail::kEpsilon) * detail::kEpsilon;
+constexpr double kOrientBoundC =
+    (9.0 + 64.0 * detail::kEpsilon) * detail::kEpsilon * detail::kEpsilon;
+
+inline void two_sum(double a, double b, double& x, double& y) {
+    x = a + b;
+    const double bv = x - a;
+    const double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+inline void fast_two_sum(double a, double b, double& x, double& y) {
+    x = a + b;
+    y = b - (x - a);
+}
+
+inline double two_diff_tail(double a, double b, double x) {
+    const double bv = a - x;
+    const double av = x + bv;
+    return (a - av) + (bv - b);
+}
+
+inline void two_diff(double a, double b, double& x, double& y) {
+    x = a - b;
+    y = two_diff_tail(a, b, x);
+}
+
+inline void split(double a, double& hi, double& lo) {
+    const double c = kSplitter * a;
+    hi = c - (c - a);
+    lo = a - hi;
+}
+
+inline void two_product(double a, double b, double& x, double& y) {
+    x = a * b;
+    double ahi, alo, bhi, blo;
+    split(a, ahi, alo);
+    split(b, bhi, blo);
+    const double err1 = x - ahi * bhi;
+    const double err2 = err1 - alo * bhi;
+    const double err3 = err2 - ahi * blo;
+    y = alo * blo - err3;
+}
+
+inline void two_product_presplit(double a, double b, double bhi, double blo,
+                                 double& x, double& y)
+{
+    x = a * b;
+    double ahi, alo;
+    split(a, ahi, alo);
+    const double err1 = x - ahi * bhi;
+    const double err2 = err1 - alo * bhi;
+    const double err3 = err2 - ahi * blo;
+    y = alo * blo - err3;
+}
+
+inline void two_one_diff(double a1, double a0, double b,
+                         double& x2, double& x1, double& x0)
+{
+    double i;
+    two_diff(a0, b, i, x0);
+    two_sum(a1, i, x2, x1);
+}
+
+// e = a1 + a0 minus b1 + b0 as a four-term expansion, least significant first.
+inline void two_two_diff(double a1, double a0, double b1, double b0, double* e) {
+    double j, z;
+    two_one_diff(a1, a0, b0, j, z, e[0]);
+    two_one_diff(j, z, b1, e[3], e[2], e[1]);
+}
+
+int expansion_sum(int elen, const double* e, int flen, const double* f, double* h) {
+    double enow = e[0];
+    double fnow = f[0];
+    int ei = 0, fi = 0, hi = 0;
+    double q, qnew, hh;
+    auto next_e = [&] { enow = ++ei < elen ? e[ei] : 0.0; };
+    auto next_f = [&] { fnow = ++fi < flen ? f[fi] : 0.0; };
+
+    if ((fnow > enow) == (fnow > -enow)) { q = enow; next_e(); }
+    else { q = fnow; next_f(); }
+
+    if (ei < elen && fi < flen) {
+        if ((fnow > enow) == (fnow > -enow)) { fast_two_sum(enow, q, qnew, hh); next_e(); }
+        else { fast_two_sum(fnow, q, qnew, hh); next_f(); }
+        q = qnew;
+        if (hh != 0.0) h[hi++] = hh;
+        while (ei < elen && fi < flen) {
+            if ((fnow > enow) == (fnow > -enow)) { two_sum(q, enow, qnew, hh); next_e(); }
+            else { two_sum(q, fnow, qnew, hh); next_f(); }
+            q = qnew;
+            if (hh != 0.0) h[hi++] = hh;
+        }
+    }
+    while (ei < elen) {
+        two_sum(q, enow, qnew, hh);
+        next_e();
+        q = qnew;
+        if (hh != 0.0) h[hi++] = hh;
+    }
+    while (fi < flen) {
+        two_sum(q, fnow, qnew, hh);
+        next_f();
+        q = qnew;
+        if (hh != 0.0) h[hi++] = hh;
+    }
+    if (q != 0.0 || hi == 0) h[hi++] = q;
+    return hi;
+}
+
+int scale_expansion(int elen, const double* e, double b, double* h) {
+    double bhi, blo;
+    split(b, bhi, blo);
+    double q, hh;
+    two_product_presplit(e[0], b, bhi, blo, q, hh);
+    int hi = 0;
+    if (hh != 0.0) h[hi++] = hh;
+    for (int i = 1; i < elen; ++i) {
+        double p1, p0, sum;
+        two_product_presplit(e[i], b, bhi, blo, p1, p0);
+        two_sum(q, p0, sum, hh);
+        if (hh != 0.0) h[hi++] = hh;
+        fast_two_sum(p1, sum, q, hh);
+        if (hh != 0.0) h[hi++] = hh;
+    }
+    if (q != 0.0 || hi == 0) h[hi++] = q;
+    return hi;
+}
+
+double estimate(int elen, const double* e) {
+    double q = e[0];
+    for (int i = 1; i < elen; ++i) q += e[i];
+    return q;
+}
+
+void cross_minor(double ax, double ay, double bx, double by, double* e) {
+    double axby1, axby0, bxay1, bxay0;
+    two_product(ax, by, axby1, axby0);
+    two_product(bx, ay, bxay1, bxay0);
+    two_two_diff(axby1, axby0, bxay1, bxay0, e);
+}
+
+int lifted_term(int len, const double* minor, double x, double y, double sign, double* out) {
+    double t24x[24], t24y[24], t48x[48], t48y[48];
+    int xlen = scale_expansion(len, minor, x, t24x);
+    xlen = scale_expansion(xlen, t24x, sign * x, t48x);
+    int ylen = scale_expansion(len, minor, y, t24y);
+    ylen = scale_expansion(ylen, t24y, sign * y, t48y);
+    return expansion_sum(xlen, t48x, ylen, t48y, out);
+}
+}
+
+// Orientation is the cross product of a - c and b - c; the stages below
+// only see the four differences and their tails.
+double orient2d_adapt(double ax, double ay, double bx, double by,
+                      double cx, double cy, double detsum)
+{
+    return cross2d_adapt(cx, cy, ax, ay, cx, cy, bx, by, detsum);
+}
+
+double cross2d_adapt(double ax, double ay, double bx, double by,
+                     double cx, double cy, double dx, double dy, double detsum)
+{
+    const double ux = bx - ax, vx = dx - cx;
+    const double uy = by - ay, vy = dy - cy;
+
+    double detleft, detlefttail, detright, detrighttail;
+    two_product(ux, vy, detleft, detlefttail);
+    two_product(uy, vx, detright, detrighttail);
+    double B[4];
+    two_two_diff(detleft, detlefttail, detright, detrighttail, B);
+
+    double det = estimate(4, B);
+    double errbound = kOrientBoundB * detsum;
+    if (det >= errbound || -det >= errbound) return det;
+
+    const double uxtail = two_diff_tail(bx, ax, ux);
+    const double vxtail = two_diff_tail(dx, cx, vx);
+    const double uytail = two_diff_tail(by, ay, uy);
+    const double vytail = two_diff_tail(dy, cy, vy);
+    if (uxtail == 0.0 && uytail == 0.0 && vxtail == 0.0 && vytail == 0.0) return det;
+
+    errbound = kOrientBoundC * detsum + kResultBound * std::fabs(det);
+    det += (ux * vytail + vy * uxtail) - (uy * vxtail + vx * uytail);
+    if (det >= errbound || -det >= errbound) return det;
+
+    double s1, s0, t1, t0, u[4];
+    double C1[8], C2[12], D[16];
+    two_product(uxtail, vy, s1, s0);
+    two_product(uytail, vx, t1, t0);
+    two_two_diff(s1, s0, t1, t0, u);
+    const int c1len = expansion_sum(4, B, 4, u, C1);
+
+    two_product(ux, vytail, s1, s0);
+    two_product(uy, vxtail, t1, t0);
+    two_two_diff(s1, s0, t1, t0, u);
+    const int c2len = expansion_sum(c1len, C1, 4, u, C2);
+
+    two_product(uxtail, vytail, s1, s0);
+    two_product(uytail, vxtail, t1, t0);
+    two_two_diff(s1, s0, t1, t0, u);
+    const int dlen = expansion_sum(c2len, C2, 4, u, D);
+    return D[dlen - 1];
+}
+
+double incircle_adapt(double ax, double ay, double bx, double by,
+                      double cx, double cy, double dx, double dy)
+{
+    const double adx = ax - dx, ady = ay - dy;
+    const double bdx = bx - dx, bdy = by - dy;
+    const double cdx = cx - dx, cdy = cy - dy;
+    if (two_diff_tail(ax, dx, adx) == 0.0 && two_diff_tail(ay, dy, ady) == 0.0 &&
+        two_diff_tail(bx, dx, bdx) == 0.0 && two_diff_tail(by, dy, bdy) == 0.0 &&
+        two_diff_tail(cx, dx, cdx) == 0.0 && two_diff_tail(cy, dy, cdy) == 0.0) {
+        double bc[4], ca[4], ab[4];
+        cross_minor(bdx, bdy, cdx, cdy, bc);
+        cross_minor(cdx, cdy, adx, ady, ca);
+        cross_minor(adx, ady, bdx, bdy, ab);
+
+        double adet[32], bdet[32], cdet[32], abdet[64], fin[96];
+        const int alen = lifted_term(4, bc, adx, ady, 1.0, adet);
+        const int blen = lifted_term(4, ca, bdx, bdy, 1.0, bdet);
+        const int clen = lifted_term(4, ab, cdx, cdy, 1.0, cdet);
+        const int ablen = expansion_sum(alen, adet, blen, bdet, abdet);
+        const int finlen = expansion_sum(ablen, abdet, clen, cdet, fin);
+        return fin[finlen - 1];
+    }
+
+    double ab[4], bc[4], cd[4], da[4], ac[4], bd[4];
+    cross_minor(ax, ay, bx, by, ab);
+    cross_minor(bx, by, cx, cy, bc);
+    cross_minor(cx, cy, dx, dy, cd);
+    cross_minor(dx, dy, ax, ay, da);
+    cross_minor(ax, ay, cx, cy, ac);
+    cross_minor(bx, by, dx, dy, bd);
+
+    double temp8[8], abc[12], bcd[12], cda[12], dab[12];
+    int templen = expansion_sum(4, cd, 4, da, temp8);
+    const int cdalen = expansion_sum(templen, temp8, 4, ac, cda);
+    templen = expansion_sum(4, da, 4, ab, temp8);
+    const int dablen = expansion_sum(templen, temp8, 4, bd, dab);
+    for (int i = 0; i < 4; ++i) {
+        bd[i] = -bd[i];
+        ac[i] = -ac[i];
+    }
+    templen = expansion_sum(4, ab, 4, bc, temp8);
+    const int abclen = expansion_sum(templen, temp8, 4, ac, abc);
+    templen = expansion_sum(4, bc, 4, cd, temp8);
+    const int bcdlen = expansion_sum(templen, temp8, 4, bd, bcd);
+
+    double adet[96], bdet[96], cdet[96], ddet[96];
+    const int alen = lifted_term(bcdlen, bcd, ax, ay, 1.0, adet);
+    const int blen = lifted_term(cdalen, cda, bx, by, -1.0, bdet);
+    const int clen = lifted_term(dablen, dab, cx, cy, 1.0, cdet);
+    const int dlen = lifted_term(abclen, abc, dx, dy, -1.0, ddet);
+
+    double abdet[192], cddet[192], deter[384];
+    const int ablen = expansion_sum(alen, adet, blen, bdet, abdet);
+    const int cdlen = expansion_sum(clen, cdet, dlen, ddet, cddet);
+    const int deterlen = expansion_sum(ablen, abdet, cdlen, cddet, deter);
+    return deter[deterlen - 1];
+}
+
+} 
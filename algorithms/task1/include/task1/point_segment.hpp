@@ -1,5 +1,8 @@
 #pragma once
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace task1 {
 
@@ -38,4 +41,30 @@ bool point_on_segment(const Vec2& a, const Vec2& b,
 int point_segment_relation(const Vec2& a, const Vec2& b,
                            const Vec2& p, double eps);
 
+struct PointsSoA {
+    const double* x = nullptr;
+    const double* y = nullptr;
+    size_t count = 0;
+};
+
+struct SegmentsSoA {
+    const double* ax = nullptr;
+    const double* ay = nullptr;
+    const double* bx = nullptr;
+    const double* by = nullptr;
+    size_t count = 0;
+};
+
+// Batch form of point_segment_relation: (*out)[i] is 0, 1 or -1 for point i.
+// The tolerance test is |cross| <= eps * |ab| instead of a division, so
+// points within rounding of the eps band may differ from the scalar call.
+bool point_segment_relations(const Vec2& a, const Vec2& b,
+                             const PointsSoA& pts, double eps,
+                             std::vector<int8_t>* out);
+
+// Point i against segment i; returns false when the counts differ.
+bool point_segment_relations(const SegmentsSoA& segs,
+                             const PointsSoA& pts, double eps,
+                             std::vector<int8_t>* out);
+
 } 
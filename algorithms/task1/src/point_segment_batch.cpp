@@ -0,0 +1,211 @@
+#include "task1/point_segment.hpp"
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <immintrin.h>
+#define TASK1_X86 1
+#endif
+
+namespace task1 {
+namespace {
+constexpr double kTiny = 1e-12;
+
+struct Seg {
+    double ax, ay, abx, aby;
+    double slack;
+    double hi;
+    bool degenerate;
+};
+
+inline Seg make_seg(double ax, double ay, double bx, double by, double eps) {
+    const double abx = bx - ax, aby = by - ay;
+    const double len2 = abx * abx + aby * aby;
+    const double len = std::sqrt(len2);
+    return Seg{ax, ay, abx, aby, eps * len, len2 + eps * len, len < kTiny};
+}
+
+inline int8_t classify(const Seg& s, double px, double py, double eps) {
+    const double apx = px - s.ax, apy = py - s.ay;
+    const double c = s.abx * apy - s.aby * apx;
+    bool on;
+    if (s.degenerate) {
+        on = apx * apx + apy * apy <= eps * eps;
+    } else {
+        const double d = s.abx * apx + s.aby * apy;
+        on = std::fabs(c) <= s.slack && d >= -s.slack && d <= s.hi;
+    }
+    if (on) return 0;
+    return static_cast<int8_t>((c > 0.0) - (c < 0.0));
+}
+
+inline void store(int on, int pos, int neg, int lanes, int8_t* out) {
+    for (int k = 0; k < lanes; ++k) {
+        out[k] = (on >> k & 1) ? 0
+               : static_cast<int8_t>((pos >> k & 1) - (neg >> k & 1));
+    }
+}
+
+void one_segment_scalar(const Seg& s, const PointsSoA& pts, double eps,
+                        size_t from, int8_t* out)
+{
+    for (size_t i = from; i < pts.count; ++i) out[i] = classify(s, pts.x[i], pts.y[i], eps);
+}
+
+void many_segments_scalar(const SegmentsSoA& segs, const PointsSoA& pts,
+                          double eps, size_t from, int8_t* out)
+{
+    for (size_t i = from; i < pts.count; ++i) {
+        const Seg s = make_seg(segs.ax[i], segs.ay[i], segs.bx[i], segs.by[i], eps);
+        out[i] = classify(s, pts.x[i], pts.y[i], eps);
+    }
+}
+
+#ifdef TASK1_X86
+size_t one_segment_sse2(const Seg& s, const PointsSoA& pts, int8_t* out) {
+    const __m128d ax = _mm_set1_pd(s.ax), ay = _mm_set1_pd(s.ay);
+    const __m128d abx = _mm_set1_pd(s.abx), aby = _mm_set1_pd(s.aby);
+    const __m128d slack = _mm_set1_pd(s.slack), lo = _mm_set1_pd(-s.slack);
+    const __m128d hi = _mm_set1_pd(s.hi);
+    const __m128d zero = _mm_setzero_pd(), sign = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= pts.count; i += 2) {
+        const __m128d apx = _mm_sub_pd(_mm_loadu_pd(pts.x + i), ax);
+        const __m128d apy = _mm_sub_pd(_mm_loadu_pd(pts.y + i), ay);
+        const __m128d c = _mm_sub_pd(_mm_mul_pd(abx, apy), _mm_mul_pd(aby, apx));
+        const __m128d d = _mm_add_pd(_mm_mul_pd(abx, apx), _mm_mul_pd(aby, apy));
+        const __m128d on = _mm_and_pd(_mm_cmple_pd(_mm_andnot_pd(sign, c), slack),
+                           _mm_and_pd(_mm_cmpge_pd(d, lo), _mm_cmple_pd(d, hi)));
+        store(_mm_movemask_pd(on), _mm_movemask_pd(_mm_cmpgt_pd(c, zero)),
+              _mm_movemask_pd(_mm_cmplt_pd(c, zero)), 2, out + i);
+    }
+    return i;
+}
+
+size_t many_segments_sse2(const SegmentsSoA& segs, const PointsSoA& pts,
+                          double eps, int8_t* out)
+{
+    const __m128d e = _mm_set1_pd(eps), e2 = _mm_set1_pd(eps * eps);
+    const __m128d tiny = _mm_set1_pd(kTiny);
+    const __m128d zero = _mm_setzero_pd(), sign = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= pts.count; i += 2) {
+        const __m128d ax = _mm_loadu_pd(segs.ax + i), ay = _mm_loadu_pd(segs.ay + i);
+        const __m128d abx = _mm_sub_pd(_mm_loadu_pd(segs.bx + i), ax);
+        const __m128d aby = _mm_sub_pd(_mm_loadu_pd(segs.by + i), ay);
+        const __m128d len2 = _mm_add_pd(_mm_mul_pd(abx, abx), _mm_mul_pd(aby, aby));
+        const __m128d len = _mm_sqrt_pd(len2);
+        const __m128d slack = _mm_mul_pd(e, len);
+        const __m128d apx = _mm_sub_pd(_mm_loadu_pd(pts.x + i), ax);
+        const __m128d apy = _mm_sub_pd(_mm_loadu_pd(pts.y + i), ay);
+        const __m128d c = _mm_sub_pd(_mm_mul_pd(abx, apy), _mm_mul_pd(aby, apx));
+        const __m128d d = _mm_add_pd(_mm_mul_pd(abx, apx), _mm_mul_pd(aby, apy));
+        const __m128d band = _mm_and_pd(_mm_cmple_pd(_mm_andnot_pd(sign, c), slack),
+                             _mm_and_pd(_mm_cmpge_pd(d, _mm_sub_pd(zero, slack)),
+                                        _mm_cmple_pd(d, _mm_add_pd(len2, slack))));
+        const __m128d near = _mm_cmple_pd(
+            _mm_add_pd(_mm_mul_pd(apx, apx), _mm_mul_pd(apy, apy)), e2);
+        const __m128d deg = _mm_cmplt_pd(len, tiny);
+        const __m128d on = _mm_or_pd(_mm_and_pd(deg, near), _mm_andnot_pd(deg, band));
+        store(_mm_movemask_pd(on), _mm_movemask_pd(_mm_cmpgt_pd(c, zero)),
+              _mm_movemask_pd(_mm_cmplt_pd(c, zero)), 2, out + i);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t one_segment_avx2(const Seg& s, const PointsSoA& pts, int8_t* out) {
+    const __m256d ax = _mm256_set1_pd(s.ax), ay = _mm256_set1_pd(s.ay);
+    const __m256d abx = _mm256_set1_pd(s.abx), aby = _mm256_set1_pd(s.aby);
+    const __m256d slack = _mm256_set1_pd(s.slack), lo = _mm256_set1_pd(-s.slack);
+    const __m256d hi = _mm256_set1_pd(s.hi);
+    const __m256d zero = _mm256_setzero_pd(), sign = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= pts.count; i += 4) {
+        const __m256d apx = _mm256_sub_pd(_mm256_loadu_pd(pts.x + i), ax);
+        const __m256d apy = _mm256_sub_pd(_mm256_loadu_pd(pts.y + i), ay);
+        const __m256d c = _mm256_sub_pd(_mm256_mul_pd(abx, apy), _mm256_mul_pd(aby, apx));
+        const __m256d d = _mm256_add_pd(_mm256_mul_pd(abx, apx), _mm256_mul_pd(aby, apy));
+        const __m256d on = _mm256_and_pd(
+            _mm256_cmp_pd(_mm256_andnot_pd(sign, c), slack, _CMP_LE_OQ),
+            _mm256_and_pd(_mm256_cmp_pd(d, lo, _CMP_GE_OQ), _mm256_cmp_pd(d, hi, _CMP_LE_OQ)));
+        store(_mm256_movemask_pd(on),
+              _mm256_movemask_pd(_mm256_cmp_pd(c, zero, _CMP_GT_OQ)),
+              _mm256_movemask_pd(_mm256_cmp_pd(c, zero, _CMP_LT_OQ)), 4, out + i);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t many_segments_avx2(const SegmentsSoA& segs, const PointsSoA& pts,
+                          double eps, int8_t* out)
+{
+    const __m256d e = _mm256_set1_pd(eps), e2 = _mm256_set1_pd(eps * eps);
+    const __m256d tiny = _mm256_set1_pd(kTiny);
+    const __m256d zero = _mm256_setzero_pd(), sign = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= pts.count; i += 4) {
+        const __m256d ax = _mm256_loadu_pd(segs.ax + i), ay = _mm256_loadu_pd(segs.ay + i);
+        const __m256d abx = _mm256_sub_pd(_mm256_loadu_pd(segs.bx + i), ax);
+        const __m256d aby = _mm256_sub_pd(_mm256_loadu_pd(segs.by + i), ay);
+        const __m256d len2 = _mm256_add_pd(_mm256_mul_pd(abx, abx), _mm256_mul_pd(aby, aby));
+        const __m256d len = _mm256_sqrt_pd(len2);
+        const __m256d slack = _mm256_mul_pd(e, len);
+        const __m256d apx = _mm256_sub_pd(_mm256_loadu_pd(pts.x + i), ax);
+        const __m256d apy = _mm256_sub_pd(_mm256_loadu_pd(pts.y + i), ay);
+        const __m256d c = _mm256_sub_pd(_mm256_mul_pd(abx, apy), _mm256_mul_pd(aby, apx));
+        const __m256d d = _mm256_add_pd(_mm256_mul_pd(abx, apx), _mm256_mul_pd(aby, apy));
+        const __m256d band = _mm256_and_pd(
+            _mm256_cmp_pd(_mm256_andnot_pd(sign, c), slack, _CMP_LE_OQ),
+            _mm256_and_pd(_mm256_cmp_pd(d, _mm256_sub_pd(zero, slack), _CMP_GE_OQ),
+                          _mm256_cmp_pd(d, _mm256_add_pd(len2, slack), _CMP_LE_OQ)));
+        const __m256d near = _mm256_cmp_pd(
+            _mm256_add_pd(_mm256_mul_pd(apx, apx), _mm256_mul_pd(apy, apy)), e2, _CMP_LE_OQ);
+        const __m256d deg = _mm256_cmp_pd(len, tiny, _CMP_LT_OQ);
+        const __m256d on = _mm256_or_pd(_mm256_and_pd(deg, near), _mm256_andnot_pd(deg, band));
+        store(_mm256_movemask_pd(on),
+              _mm256_movemask_pd(_mm256_cmp_pd(c, zero, _CMP_GT_OQ)),
+              _mm256_movemask_pd(_mm256_cmp_pd(c, zero, _CMP_LT_OQ)), 4, out + i);
+    }
+    return i;
+}
+
+bool has_avx2() {
+    static const bool ok = __builtin_cpu_supports("avx2");
+    return ok;
+}
+#endif
+}
+
+bool point_segment_relations(const Vec2& a, const Vec2& b,
+                             const PointsSoA& pts, double eps,
+                             std::vector<int8_t>* out)
+{
+    out->resize(pts.count);
+    const Seg s = make_seg(a.x, a.y, b.x, b.y, eps);
+    size_t done = 0;
+#ifdef TASK1_X86
+    if (!s.degenerate) {
+        done = has_avx2() ? one_segment_avx2(s, pts, out->data())
+                          : one_segment_sse2(s, pts, out->data());
+    }
+#endif
+    one_segment_scalar(s, pts, eps, done, out->data());
+    return true;
+}
+
+bool point_segment_relations(const SegmentsSoA& segs,
+                             const PointsSoA& pts, double eps,
+                             std::vector<int8_t>* out)
+{
+    out->clear();
+    if (segs.count != pts.count) return false;
+    out->resize(pts.count);
+    size_t done = 0;
+#ifdef TASK1_X86
+    done = has_avx2() ? many_segments_avx2(segs, pts, eps, out->data())
+                      : many_segments_sse2(segs, pts, eps, out->data());
+#endif
+    many_segments_scalar(segs, pts, eps, done, out->data());
+    return true;
+}
+
+} 
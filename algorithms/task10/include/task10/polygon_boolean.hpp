@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 namespace task10 {
@@ -24,4 +25,25 @@ std::vector<Polygon> boolean_operation(const Polygon& a,
                                        const Polygon& b,
                                        Operation op);
 
+// boolean_operation for inputs that change one at a time, e.g. while a
+// vertex is dragged. Each input keeps its Clipper integer paths and vertex
+// data; setting a polygon equal to the current one keeps them, so only the
+// changed input is converted again. The engine and result tree are reused.
+class BooleanSession {
+public:
+    BooleanSession();
+    ~BooleanSession();
+    BooleanSession(BooleanSession&& other) noexcept;
+    BooleanSession& operator=(BooleanSession&& other) noexcept;
+
+    void set_a(const Polygon& a);
+    void set_b(const Polygon& b);
+
+    std::vector<Polygon> execute(Operation op);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 }
@@ -12,9 +12,9 @@ namespace {
 
 constexpr double kScale = 1e6;
 
-Clipper2Lib::Path64 to_path(const Loop& loop) {
-    Clipper2Lib::Path64 path;
-    path.reserve(loop.vertices.size());
+void to_path(const Loop& loop, Clipper2Lib::Path64* path) {
+    path->clear();
+    path->reserve(loop.vertices.size());
     for (const auto& v : loop.vertices) {
         const double xs = std::clamp(v.x * kScale,
                                      static_cast<double>(std::numeric_limits<int64_t>::min() / 2),
@@ -22,19 +22,20 @@ Clipper2Lib::Path64 to_path(const Loop& loop) {
         const double ys = std::clamp(v.y * kScale,
                                      static_cast<double>(std::numeric_limits<int64_t>::min() / 2),
                                      static_cast<double>(std::numeric_limits<int64_t>::max() / 2));
-        path.emplace_back(static_cast<int64_t>(std::llround(xs)),
-                          static_cast<int64_t>(std::llround(ys)));
+        path->emplace_back(static_cast<int64_t>(std::llround(xs)),
+                           static_cast<int64_t>(std::llround(ys)));
     }
-    return path;
 }
 
-Clipper2Lib::Paths64 to_paths(const Polygon& poly) {
-    Clipper2Lib::Paths64 paths;
+// Refills `paths` in place, so the inner paths keep their capacity.
+void to_paths(const Polygon& poly, Clipper2Lib::Paths64* paths) {
+    size_t count = 0;
     for (const auto& loop : poly.loops) {
         if (loop.vertices.size() < 3) continue;
-        paths.push_back(to_path(loop));
+        if (count == paths->size()) paths->emplace_back();
+        to_path(loop, &(*paths)[count++]);
     }
-    return paths;
+    paths->resize(count);
 }
 
 Loop from_path(const Clipper2Lib::Path64& path, bool hole) {
@@ -48,18 +49,19 @@ Loop from_path(const Clipper2Lib::Path64& path, bool hole) {
     return loop;
 }
 
+// Owners are passed by index: islands append to `result`, which may move it.
 void append_children(const Clipper2Lib::PolyPath64& node,
                      std::vector<Polygon>& result,
-                     Polygon& owner) {
+                     size_t owner) {
     for (size_t i = 0; i < node.Count(); ++i) {
         const auto& child = *node.Child(i);
         if (child.IsHole()) {
-            owner.loops.push_back(from_path(child.Polygon(), true));
+            result[owner].loops.push_back(from_path(child.Polygon(), true));
             append_children(child, result, owner);
         } else {
             result.emplace_back();
-            auto& next = result.back();
-            next.loops.push_back(from_path(child.Polygon(), false));
+            const size_t next = result.size() - 1;
+            result[next].loops.push_back(from_path(child.Polygon(), false));
             append_children(child, result, next);
         }
     }
@@ -71,8 +73,8 @@ std::vector<Polygon> from_tree(const Clipper2Lib::PolyTree64& tree) {
         const auto& node = *tree[i];
         if (node.IsHole()) continue;
         polys.emplace_back();
-        auto& poly = polys.back();
-        poly.loops.push_back(from_path(node.Polygon(), false));
+        const size_t poly = polys.size() - 1;
+        polys[poly].loops.push_back(from_path(node.Polygon(), false));
         append_children(node, polys, poly);
     }
     return polys;
@@ -90,14 +92,32 @@ Clipper2Lib::ClipType clip_type(Operation op) {
     return Clipper2Lib::ClipType::Union;
 }
 
+bool same_polygon(const Polygon& a, const Polygon& b) {
+    if (a.loops.size() != b.loops.size()) return false;
+    for (size_t i = 0; i < a.loops.size(); ++i) {
+        const Loop& la = a.loops[i];
+        const Loop& lb = b.loops[i];
+        if (la.hole != lb.hole || la.vertices.size() != lb.vertices.size()) return false;
+        for (size_t k = 0; k < la.vertices.size(); ++k) {
+            if (la.vertices[k].x != lb.vertices[k].x || la.vertices[k].y != lb.vertices[k].y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 }  
 
 std::vector<Polygon> boolean_operation(const Polygon& a,
                                        const Polygon& b,
                                        Operation op) {
+    Clipper2Lib::Paths64 subject, clip;
+    to_paths(a, &subject);
+    to_paths(b, &clip);
     Clipper2Lib::Clipper64 clipper;
-    clipper.AddSubject(to_paths(a));
-    clipper.AddClip(to_paths(b));
+    clipper.AddSubject(subject);
+    clipper.AddClip(clip);
     Clipper2Lib::PolyTree64 tree;
     Clipper2Lib::Paths64 open;
     clipper.Execute(clip_type(op),
@@ -107,4 +127,53 @@ std::vector<Polygon> boolean_operation(const Polygon& a,
     return from_tree(tree);
 }
 
+// The engine only borrows the vertices of a ReuseableDataContainer64, so
+// each input's container lives here for as long as the input is unchanged.
+struct BooleanSession::Impl {
+    struct Input {
+        Polygon source;
+        Clipper2Lib::Paths64 paths;
+        Clipper2Lib::ReuseableDataContainer64 data;
+        bool valid = false;
+    };
+
+    Input inputs[2];
+    Clipper2Lib::Clipper64 clipper;
+    Clipper2Lib::PolyTree64 tree;
+    Clipper2Lib::Paths64 open;
+
+    void set(Input& in, const Polygon& poly, Clipper2Lib::PathType type) {
+        if (in.valid && same_polygon(in.source, poly)) return;
+        in.source = poly;
+        to_paths(poly, &in.paths);
+        in.data.Clear();
+        in.data.AddPaths(in.paths, type, false);
+        in.valid = true;
+    }
+};
+
+BooleanSession::BooleanSession() : impl_(std::make_unique<Impl>()) {}
+BooleanSession::~BooleanSession() = default;
+BooleanSession::BooleanSession(BooleanSession&& other) noexcept = default;
+BooleanSession& BooleanSession::operator=(BooleanSession&& other) noexcept = default;
+
+void BooleanSession::set_a(const Polygon& a) {
+    impl_->set(impl_->inputs[0], a, Clipper2Lib::PathType::Subject);
+}
+
+void BooleanSession::set_b(const Polygon& b) {
+    impl_->set(impl_->inputs[1], b, Clipper2Lib::PathType::Clip);
+}
+
+std::vector<Polygon> BooleanSession::execute(Operation op) {
+    Impl& s = *impl_;
+    s.clipper.Clear();
+    for (const auto& in : s.inputs) s.clipper.AddReuseableData(in.data);
+    s.clipper.Execute(clip_type(op),
+                      Clipper2Lib::FillRule::NonZero,
+                      s.tree,
+                      s.open);
+    return from_tree(s.tree);
+}
+
 }
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <limits>
 
+#include "common/predicates.hpp"
+
 namespace task11 {
 namespace {
 
@@ -11,8 +13,17 @@ long double cross(const Point& a, const Point& b, const Point& c) {
     return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
 }
 
+// Exact side test on the coordinates narrowed to double. The points are
+// doubles widened to long double (canvas clicks and point files), so the
+// narrowing is exact for them.
+double orient(const Point& a, const Point& b, const Point& c) {
+    return common::orient2d(static_cast<double>(a.x), static_cast<double>(a.y),
+                            static_cast<double>(b.x), static_cast<double>(b.y),
+                            static_cast<double>(c.x), static_cast<double>(c.y));
+}
+
 bool on_segment(const Point& a, const Point& b, const Point& p, long double eps) {
-    if (std::fabsl(cross(a, b, p)) > eps) return false;
+    if (std::fabs(cross(a, b, p)) > eps) return false;
     const long double dot = (p.x - a.x) * (p.x - b.x) + (p.y - a.y) * (p.y - b.y);
     return dot <= eps;
 }
@@ -37,7 +48,7 @@ std::vector<Point> convex_hull(const std::vector<Point>& pts) {
     hull.reserve(sorted.size() * 2);
     for (const auto& p : sorted) {
         while (hull.size() >= 2 &&
-               cross(hull[hull.size() - 2], hull.back(), p) <= 0.0L) {
+               orient(hull[hull.size() - 2], hull.back(), p) <= 0.0) {
             hull.pop_back();
         }
         hull.push_back(p);
@@ -46,7 +57,7 @@ std::vector<Point> convex_hull(const std::vector<Point>& pts) {
     for (int i = static_cast<int>(sorted.size()) - 2; i >= 0; --i) {
         const auto& p = sorted[i];
         while (hull.size() > lower &&
-               cross(hull[hull.size() - 2], hull.back(), p) <= 0.0L) {
+               orient(hull[hull.size() - 2], hull.back(), p) <= 0.0) {
             hull.pop_back();
         }
         hull.push_back(p);
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <limits>
 
+#include "common/predicates.hpp"
+
 namespace task12 {
 namespace {
 
@@ -11,8 +13,17 @@ long double cross(const Point& a, const Point& b, const Point& c) {
     return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
 }
 
+// Exact side test on the coordinates narrowed to double. The points are
+// doubles widened to long double (canvas clicks and point files), so the
+// narrowing is exact for them.
+double orient(const Point& a, const Point& b, const Point& c) {
+    return common::orient2d(static_cast<double>(a.x), static_cast<double>(a.y),
+                            static_cast<double>(b.x), static_cast<double>(b.y),
+                            static_cast<double>(c.x), static_cast<double>(c.y));
+}
+
 bool on_segment(const Point& a, const Point& b, const Point& p, long double eps) {
-    if (std::fabsl(cross(a, b, p)) > eps) return false;
+    if (std::fabs(cross(a, b, p)) > eps) return false;
     const long double dot = (p.x - a.x) * (p.x - b.x) + (p.y - a.y) * (p.y - b.y);
     return dot <= eps;
 }
@@ -59,14 +70,14 @@ ContourStats analyze(const Contour& contour, const Point& query, long double eps
         const bool upward = (a.y <= query.y);
         const bool upwardCross = upward && (b.y > query.y);
         const bool downwardCross = (a.y > query.y) && (b.y <= query.y);
-        const long double isLeft = cross(a, b, query);
-        if (upwardCross && isLeft > eps) ++stats.winding;
-        else if (downwardCross && isLeft < -eps) --stats.winding;
+        const double isLeft = orient(a, b, query);
+        if (upwardCross && isLeft > 0.0) ++stats.winding;
+        else if (downwardCross && isLeft < 0.0) --stats.winding;
         const bool crosses = ((a.y > query.y) != (b.y > query.y));
         if (crosses) {
             const long double t = (query.y - a.y) / (b.y - a.y);
             const long double xEdge = a.x + t * (b.x - a.x);
-            if (std::fabsl(xEdge - query.x) <= eps) {
+            if (std::fabs(xEdge - query.x) <= eps) {
                 stats.boundary = true;
                 stats.minDistance = 0.0L;
                 return stats;
@@ -1,6 +1,7 @@
 #pragma once
 #include <cmath>
 #include <optional>
+#include <vector>
 
 namespace task2 {
 
@@ -41,4 +42,28 @@ std::optional<Vec2> segment_intersection(const Vec2& a, const Vec2& b,
                                          const Vec2& c, const Vec2& d,
                                          double eps);
 
+struct Segment {
+    Vec2 a;
+    Vec2 b;
+};
+
+struct SegmentIntersection {
+    int first = -1;
+    int second = -1;
+    Vec2 point;
+};
+
+// Bentley-Ottmann sweep. Reports each pair first < second for which
+// segment_intersection(eps) holds, sorted by (first, second). Exact
+// crossings, touches and collinear overlaps are always found; near misses
+// within eps are found when the two segments are neighbours in the sweep.
+bool all_intersections(const std::vector<Segment>& segments, double eps,
+                       std::vector<SegmentIntersection>* out);
+
+// Same contract as all_intersections, found through a uniform grid sized
+// from the data; cells are processed on `threads` workers (0 = all cores).
+// Suits many short segments; every pair within eps is reported.
+bool grid_intersections(const std::vector<Segment>& segments, double eps,
+                        std::vector<SegmentIntersection>* out, int threads = 0);
+
 } 
@@ -0,0 +1,176 @@
+#include "task2/segment_intersection.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "common/parallel.hpp"
+
+namespace task2 {
+namespace {
+struct Box {
+    double minx, miny, maxx, maxy;
+};
+
+class Grid {
+public:
+    Grid(const std::vector<Segment>& segs, double eps) : segs_(segs) {
+        const size_t n = segs.size();
+        pad_.resize(n);
+        boxes_.resize(n);
+        Box all{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+        double extent = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const Segment& g = segs[i];
+            pad_[i] = eps * (1.0 + length(g.b - g.a));
+            Box& b = boxes_[i];
+            b.minx = std::min(g.a.x, g.b.x) - pad_[i];
+            b.maxx = std::max(g.a.x, g.b.x) + pad_[i];
+            b.miny = std::min(g.a.y, g.b.y) - pad_[i];
+            b.maxy = std::max(g.a.y, g.b.y) + pad_[i];
+            all.minx = std::min(all.minx, b.minx);
+            all.miny = std::min(all.miny, b.miny);
+            all.maxx = std::max(all.maxx, b.maxx);
+            all.maxy = std::max(all.maxy, b.maxy);
+            extent += std::max(b.maxx - b.minx, b.maxy - b.miny);
+        }
+        if (n == 0) return;
+
+        const double w = std::max(all.maxx - all.minx, 0.0);
+        const double h = std::max(all.maxy - all.miny, 0.0);
+        double cell = std::max(extent / static_cast<double>(n),
+                               std::sqrt(w * h / static_cast<double>(n)));
+        const double budget = 4.0 * static_cast<double>(n) + 16.0;
+        if (!(cell > 0.0)) cell = std::max(std::max(w, h), 1.0);
+        while ((w / cell + 1.0) * (h / cell + 1.0) > budget) cell *= 2.0;
+
+        ox_ = all.minx;
+        oy_ = all.miny;
+        inv_ = 1.0 / cell;
+        cell_ = cell;
+        nx_ = static_cast<int>(w * inv_) + 1;
+        ny_ = static_cast<int>(h * inv_) + 1;
+
+        start_.assign(static_cast<size_t>(nx_) * ny_ + 1, 0);
+        first_.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            first_[i + 1] = first_[i];
+            cover(static_cast<int>(i), [&](int c) { ++start_[c + 1]; ++first_[i + 1]; });
+        }
+        for (size_t c = 1; c < start_.size(); ++c) start_[c] += start_[c - 1];
+        members_.resize(start_.back());
+        cells_.resize(first_.back());
+        std::vector<uint32_t> fill(start_.begin(), start_.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t k = first_[i];
+            cover(static_cast<int>(i), [&](int c) {
+                members_[fill[c]++] = static_cast<int>(i);
+                cells_[k++] = c;
+            });
+        }
+    }
+
+    int cells() const { return static_cast<int>(start_.size()) - 1; }
+
+    template <class Emit>
+    void scan(int c, Emit&& emit) const {
+        for (uint32_t u = start_[c]; u < start_[c + 1]; ++u) {
+            for (uint32_t v = u + 1; v < start_[c + 1]; ++v) {
+                const int i = members_[u], j = members_[v];
+                if (!overlap(i, j) || first_common(i, j) != c) continue;
+                emit(std::min(i, j), std::max(i, j));
+            }
+        }
+    }
+
+private:
+    int column(double x) const { return std::clamp(static_cast<int>((x - ox_) * inv_), 0, nx_ - 1); }
+    int row(double y) const { return std::clamp(static_cast<int>((y - oy_) * inv_), 0, ny_ - 1); }
+
+    template <class Visit>
+    void cover(int i, Visit&& visit) const {
+        const Segment& g = segs_[i];
+        const Box& b = boxes_[i];
+        const double slack = pad_[i] + cell_ * 1e-9;
+        const int c0 = column(b.minx), c1 = column(b.maxx);
+        const double dx = g.b.x - g.a.x;
+        for (int c = c0; c <= c1; ++c) {
+            double lo = b.miny, hi = b.maxy;
+            if (c0 != c1 && dx != 0.0) {
+                const double xl = std::max(std::min(g.a.x, g.b.x), ox_ + c * cell_ - slack);
+                const double xr = std::min(std::max(g.a.x, g.b.x), ox_ + (c + 1) * cell_ + slack);
+                const double yl = g.a.y + (g.b.y - g.a.y) * ((xl - g.a.x) / dx);
+                const double yr = g.a.y + (g.b.y - g.a.y) * ((xr - g.a.x) / dx);
+                lo = std::max(lo, std::min(yl, yr) - slack);
+                hi = std::min(hi, std::max(yl, yr) + slack);
+            }
+            const int r0 = row(lo), r1 = row(hi);
+            for (int r = r0; r <= r1; ++r) visit(c * ny_ + r);
+        }
+    }
+
+    bool overlap(int i, int j) const {
+        const Box& a = boxes_[i];
+        const Box& b = boxes_[j];
+        return a.minx <= b.maxx && b.minx <= a.maxx && a.miny <= b.maxy && b.miny <= a.maxy;
+    }
+
+    int first_common(int i, int j) const {
+        uint32_t u = first_[i], v = first_[j];
+        while (u < first_[i + 1] && v < first_[j + 1]) {
+            if (cells_[u] == cells_[v]) return cells_[u];
+            if (cells_[u] < cells_[v]) ++u; else ++v;
+        }
+        return -1;
+    }
+
+    const std::vector<Segment>& segs_;
+    std::vector<double> pad_;
+    std::vector<Box> boxes_;
+    double ox_ = 0.0, oy_ = 0.0, inv_ = 1.0, cell_ = 1.0;
+    int nx_ = 1, ny_ = 1;
+    std::vector<uint32_t> start_;
+    std::vector<int> members_;
+    std::vector<uint32_t> first_;
+    std::vector<int> cells_;
+};
+}
+
+bool grid_intersections(const std::vector<Segment>& segments, double eps,
+                        std::vector<SegmentIntersection>* out, int threads)
+{
+    out->clear();
+    if (segments.size() < 2) return false;
+
+    const Grid grid(segments, eps);
+    const int workers = common::resolve_threads(threads);
+    std::vector<std::vector<SegmentIntersection>> found(workers);
+    constexpr int kBlock = 256;
+    const int cells = grid.cells();
+    const size_t blocks = static_cast<size_t>((cells + kBlock - 1) / kBlock);
+    common::parallel_for(blocks, workers, [&](size_t blk, int worker) {
+        const int end = std::min(cells, static_cast<int>(blk + 1) * kBlock);
+        for (int c = static_cast<int>(blk) * kBlock; c < end; ++c) {
+            grid.scan(c, [&](int i, int j) {
+                Vec2 pt;
+                if (segment_intersection(segments[i].a, segments[i].b,
+                                         segments[j].a, segments[j].b, eps, &pt)) {
+                    found[worker].push_back(SegmentIntersection{i, j, pt});
+                }
+            });
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& f : found) total += f.size();
+    out->reserve(total);
+    for (const auto& f : found) out->insert(out->end(), f.begin(), f.end());
+    std::sort(out->begin(), out->end(), [](const SegmentIntersection& u,
+                                           const SegmentIntersection& v) {
+        return u.first != v.first ? u.first < v.first : u.second < v.second;
+    });
+    return !out->empty();
+}
+
+} 
@@ -0,0 +1,227 @@
+#include "task2/segment_intersection.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <queue>
+#include <set>
+#include <unordered_set>
+
+#include "common/predicates.hpp"
+
+namespace task2 {
+namespace {
+inline bool before(const Vec2& a, const Vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+inline bool same(const Vec2& a, const Vec2& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+struct Sweep {
+    std::vector<Segment> segs;
+    Vec2 p;
+
+    double side(int s, const Vec2& q) const {
+        return common::orient2d(segs[s].a, segs[s].b, q);
+    }
+
+    bool below(int a, int b) const {
+        const double sa = side(a, p);
+        const double sb = side(b, p);
+        if (sa == 0.0 && sb == 0.0) {
+            const double o = common::orient2d(p, segs[a].b, segs[b].b);
+            if (o != 0.0) return o > 0.0;
+            return a < b;
+        }
+        if (sa == 0.0) return sb < 0.0;
+        if (sb == 0.0) return sa > 0.0;
+        // p between them decides at its own x.
+        if ((sa > 0.0) != (sb > 0.0)) return sa > 0.0;
+
+        // Both pass p on the same side. A segment with both ends on one side of
+        // the other's line stays on that side over their common x-range.
+        const double b0 = side(a, segs[b].a), b1 = side(a, segs[b].b);
+        if (b0 >= 0.0 && b1 >= 0.0 && (b0 > 0.0 || b1 > 0.0)) return true;
+        if (b0 <= 0.0 && b1 <= 0.0 && (b0 < 0.0 || b1 < 0.0)) return false;
+        const double a0 = side(b, segs[a].a), a1 = side(b, segs[a].b);
+        if (a0 >= 0.0 && a1 >= 0.0 && (a0 > 0.0 || a1 > 0.0)) return false;
+        if (a0 <= 0.0 && a1 <= 0.0 && (a0 < 0.0 || a1 < 0.0)) return true;
+        if (b0 == 0.0 && b1 == 0.0) return a < b;
+        // A proper crossing: ordered as left of it, where a's left end
+        // decides; the crossing event swaps them.
+        return a0 < 0.0;
+    }
+};
+
+struct Slot {
+    mutable int seg;
+};
+
+class Order {
+public:
+    using is_transparent = void;
+
+    explicit Order(const Sweep* sweep) : sweep_(sweep) {}
+
+    bool operator()(const Slot& a, const Slot& b) const { return sweep_->below(a.seg, b.seg); }
+    bool operator()(const Slot& a, const Vec2& q) const { return sweep_->side(a.seg, q) > 0.0; }
+    bool operator()(const Vec2& q, const Slot& a) const { return sweep_->side(a.seg, q) < 0.0; }
+
+private:
+    const Sweep* sweep_;
+};
+
+enum class Kind { Start, End, Point };
+
+struct Endpoint {
+    Vec2 p;
+    int seg;
+    Kind kind;
+};
+
+struct Crossing {
+    Vec2 p;
+    int lo;
+    int hi;
+};
+
+struct Later {
+    bool operator()(const Crossing& a, const Crossing& b) const { return before(b.p, a.p); }
+};
+
+inline uint64_t pair_key(int a, int b) {
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+}
+}
+
+bool all_intersections(const std::vector<Segment>& segments, double eps,
+                       std::vector<SegmentIntersection>* out)
+{
+    out->clear();
+    const int n = static_cast<int>(segments.size());
+
+    Sweep sweep;
+    sweep.segs.reserve(n);
+    std::vector<Endpoint> ends;
+    ends.reserve(2 * static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        Segment g = segments[i];
+        if (before(g.b, g.a)) std::swap(g.a, g.b);
+        sweep.segs.push_back(g);
+        if (same(g.a, g.b)) {
+            ends.push_back(Endpoint{g.a, i, Kind::Point});
+        } else {
+            ends.push_back(Endpoint{g.a, i, Kind::Start});
+            ends.push_back(Endpoint{g.b, i, Kind::End});
+        }
+    }
+    std::sort(ends.begin(), ends.end(), [](const Endpoint& u, const Endpoint& v) {
+        return before(u.p, v.p);
+    });
+
+    using Status = std::set<Slot, Order>;
+    Status status{Order(&sweep)};
+    std::vector<Status::iterator> where(n, status.end());
+    std::priority_queue<Crossing, std::vector<Crossing>, Later> crossings;
+    std::unordered_set<uint64_t> reported;
+
+    auto report = [&](int a, int b) {
+        if (a > b) std::swap(a, b);
+        if (!reported.insert(pair_key(a, b)).second) return;
+        Vec2 pt;
+        if (segment_intersection(segments[a].a, segments[a].b,
+                                 segments[b].a, segments[b].b, eps, &pt)) {
+            out->push_back(SegmentIntersection{a, b, pt});
+        }
+    };
+
+    auto check = [&](Status::iterator lo, Status::iterator hi) {
+        const int a = lo->seg, b = hi->seg;
+        report(a, b);
+        const Segment& A = sweep.segs[a];
+        const Segment& B = sweep.segs[b];
+        const double a0 = sweep.side(b, A.a), a1 = sweep.side(b, A.b);
+        const double b0 = sweep.side(a, B.a), b1 = sweep.side(a, B.b);
+        if (!(a1 > 0.0 && a0 < 0.0 && b0 > 0.0 && b1 < 0.0)) return;
+
+        const Vec2 r = A.b - A.a, s = B.b - B.a;
+        Vec2 q = A.a + r * (cross(B.a - A.a, s) / cross(r, s));
+        if (before(q, sweep.p)) q = sweep.p;
+        crossings.push(Crossing{q, a, b});
+    };
+
+    auto insert = [&](int s) { where[s] = status.insert(Slot{s}).first; };
+
+    std::vector<int> group, starts;
+    size_t e = 0;
+    while (e < ends.size() || !crossings.empty()) {
+        if (!crossings.empty() &&
+            (e == ends.size() || !before(ends[e].p, crossings.top().p))) {
+            const Crossing c = crossings.top();
+            crossings.pop();
+            const Status::iterator lo = where[c.lo], hi = where[c.hi];
+            if (lo == status.end() || hi == status.end() || std::next(lo) != hi) continue;
+            sweep.p = c.p;
+            lo->seg = c.hi;
+            hi->seg = c.lo;
+            where[c.hi] = lo;
+            where[c.lo] = hi;
+            if (lo != status.begin()) check(std::prev(lo), lo);
+            if (std::next(hi) != status.end()) check(hi, std::next(hi));
+            continue;
+        }
+
+        const Vec2 p = ends[e].p;
+        sweep.p = p;
+        group.clear();
+        starts.clear();
+        for (; e < ends.size() && same(ends[e].p, p); ++e) {
+            const Endpoint& ep = ends[e];
+            if (ep.kind == Kind::End) {
+                if (where[ep.seg] != status.end()) {
+                    group.push_back(ep.seg);
+                    status.erase(where[ep.seg]);
+                    where[ep.seg] = status.end();
+                }
+            } else {
+                starts.push_back(ep.seg);
+            }
+        }
+
+        const auto range = status.equal_range(p);
+        for (auto it = range.first; it != range.second; ++it) {
+            group.push_back(it->seg);
+            where[it->seg] = status.end();
+        }
+        status.erase(range.first, range.second);
+
+        group.insert(group.end(), starts.begin(), starts.end());
+        for (size_t i = 0; i < group.size(); ++i) {
+            for (size_t j = i + 1; j < group.size(); ++j) report(group[i], group[j]);
+        }
+
+        for (int s : group) {
+            const Segment& g = sweep.segs[s];
+            if (!same(g.b, p) && !same(g.a, g.b)) insert(s);
+        }
+
+        const auto block = status.equal_range(p);
+        if (block.first != block.second) {
+            if (block.first != status.begin()) check(std::prev(block.first), block.first);
+            if (block.second != status.end()) check(std::prev(block.second), block.second);
+        } else if (block.first != status.begin() && block.first != status.end()) {
+            check(std::prev(block.first), block.first);
+        }
+    }
+
+    std::sort(out->begin(), out->end(), [](const SegmentIntersection& u,
+                                           const SegmentIntersection& v) {
+        return u.first != v.first ? u.first < v.first : u.second < v.second;
+    });
+    return !out->empty();
+}
+
+} 
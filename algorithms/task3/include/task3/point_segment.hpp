@@ -0,0 +1,85 @@
+#pragma once
+#include <cmath>
+#include <type_traits>
+
+#include "common/predicates.hpp"
+
+namespace task3 {
+
+template <class T>
+struct BasicPoint {
+    T x = T(0);
+    T y = T(0);
+};
+
+// Kernel tag: double coordinates with the side test decided exactly by
+// common::orient2d. Points exactly on the segment are classified as on it
+// even with eps == 0.
+struct Exact {};
+
+template <class K>
+struct Kernel {
+    static_assert(std::is_floating_point<K>::value,
+                  "task3 kernels need float, double, long double or Exact");
+    using coord = K;
+    static constexpr bool exact = false;
+    static constexpr K tiny = std::is_same<K, float>::value ? K(1e-6)
+                            : std::is_same<K, double>::value ? K(1e-12) : K(1e-18L);
+
+    static K cross(const BasicPoint<K>& a, const BasicPoint<K>& b, const BasicPoint<K>& p) {
+        return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    }
+};
+
+template <>
+struct Kernel<Exact> {
+    using coord = double;
+    static constexpr bool exact = true;
+    static constexpr double tiny = 1e-12;
+
+    static double cross(const BasicPoint<double>& a, const BasicPoint<double>& b,
+                        const BasicPoint<double>& p) {
+        return common::orient2d(a, b, p);
+    }
+};
+
+template <class K>
+using coord_t = typename Kernel<K>::coord;
+
+template <class K>
+bool point_on_segment(const BasicPoint<coord_t<K>>& a, const BasicPoint<coord_t<K>>& b,
+                      const BasicPoint<coord_t<K>>& p, coord_t<K> eps)
+{
+    using T = coord_t<K>;
+    if (Kernel<K>::exact && Kernel<K>::cross(a, b, p) == T(0) &&
+        std::fmin(a.x, b.x) <= p.x && p.x <= std::fmax(a.x, b.x) &&
+        std::fmin(a.y, b.y) <= p.y && p.y <= std::fmax(a.y, b.y)) return true;
+
+    const T abx = b.x - a.x, aby = b.y - a.y;
+    const T apx = p.x - a.x, apy = p.y - a.y;
+    const T ab_len = std::sqrt(abx*abx + aby*aby);
+
+    if (ab_len < Kernel<K>::tiny) return std::sqrt(apx*apx + apy*apy) <= eps;
+
+    const T cross = std::fabs(abx*apy - aby*apx);
+    if (cross / ab_len > eps) return false;
+
+    const T dot = abx*apx + aby*apy;
+    const T end_slack = eps * ab_len;
+    if (dot < -end_slack)                  return false;
+    if (dot > ab_len*ab_len + end_slack)   return false;
+    return true;
+}
+
+template <class K>
+int point_segment_relation(const BasicPoint<coord_t<K>>& a, const BasicPoint<coord_t<K>>& b,
+                           const BasicPoint<coord_t<K>>& p, coord_t<K> eps)
+{
+    if (point_on_segment<K>(a, b, p, eps)) return 0;
+    const coord_t<K> cross = Kernel<K>::cross(a, b, p);
+    if (cross > 0) return 1;
+    if (cross < 0) return -1;
+    return 0;
+}
+
+} 
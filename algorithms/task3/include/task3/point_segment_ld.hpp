@@ -1,12 +1,11 @@
 #pragma once
 #include <cmath>
 
+#include "task3/point_segment.hpp"
+
 namespace task3 {
 
-struct Point {
-    long double x = 0.0L;
-    long double y = 0.0L;
-};
+using Point = BasicPoint<long double>;
 
 bool point_on_segment(const Point& a, const Point& b,
                       const Point& p, long double eps);
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+
+#include "task4/convex_hull.hpp"
+
+namespace task4 {
+
+// Queries on a hull as returned by convex_hull_indices (counter-clockwise,
+// strictly convex). All run in O(h) by rotating calipers; pair members are
+// indices into `pts`.
+
+struct PointPair {
+    int first = -1;
+    int second = -1;
+    long double distance = 0.0L;
+};
+
+struct HullWidth {
+    // The supporting hull edge and the vertex farthest from it.
+    int edge_first = -1;
+    int edge_second = -1;
+    int vertex = -1;
+    long double width = 0.0L;
+};
+
+struct BoundingRect {
+    // Counter-clockwise; corners[0] -> corners[1] runs along a hull edge.
+    Point corners[4];
+    long double area = 0.0L;
+};
+
+bool hull_diameter(const std::vector<Point>& pts, const HullIndices& hull, PointPair* out);
+bool hull_width(const std::vector<Point>& pts, const HullIndices& hull, HullWidth* out);
+bool min_area_rect(const std::vector<Point>& pts, const HullIndices& hull, BoundingRect* out);
+
+// Every antipodal vertex pair, farthest first; the first one is the diameter.
+bool farthest_pairs(const std::vector<Point>& pts, const HullIndices& hull,
+                    std::vector<PointPair>* out);
+
+// Batch forms: (*out)[i] answers hulls[i], all indexing the shared `pts`.
+// Hulls are processed in blocks on `threads` workers (0 = all cores).
+void hull_diameters(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                    std::vector<PointPair>* out, int threads = 0);
+void hull_widths(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                 std::vector<HullWidth>* out, int threads = 0);
+void min_area_rects(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                    std::vector<BoundingRect>* out, int threads = 0);
+void hull_farthest_pairs(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                         std::vector<std::vector<PointPair>>* out, int threads = 0);
+
+} 
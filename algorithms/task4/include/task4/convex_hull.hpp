@@ -1,15 +1,111 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace task4 {
 
 struct Point {
-    long double x = 0.0L;
-    long double y = 0.0L;
+    double x = 0.0;
+    double y = 0.0;
 };
 
 using HullIndices = std::vector<int>;
 
+struct HullOptions;
+
+// Buffers reused across convex_hull_indices calls; once grown to the
+// largest input seen, repeated calls on the serial path do not allocate.
+class HullScratch {
+public:
+    HullScratch();
+    ~HullScratch();
+    HullScratch(HullScratch&& other) noexcept;
+    HullScratch& operator=(HullScratch&& other) noexcept;
+
+private:
+    friend bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull,
+                                    const HullOptions& options);
+
+    struct Impl;
+    Impl& impl() { return *impl_; }
+
+    std::unique_ptr<Impl> impl_;
+};
+
+enum class HullAlgorithm {
+    MonotoneChain,
+    // Chan's O(n log h); pays off for large inputs with small hulls.
+    Chan,
+    // Chan when the input is large and the hull of a strided sample is small.
+    Auto,
+};
+
+struct HullOptions {
+    int threads = 1;
+    // Serial path only; the chunked path always uses the monotone chain.
+    HullAlgorithm algorithm = HullAlgorithm::MonotoneChain;
+    // LSD radix sort on order-preserving 64-bit keys of x instead of
+    // std::sort; runs of equal x are finished by y. The hull is the same
+    // either way.
+    bool radix = false;
+    HullScratch* scratch = nullptr;
+};
+
 bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull);
 
+// threads > 1 (or 0 = all cores) hulls contiguous chunks in parallel and
+// merges their vertices; the result matches the serial hull index for index.
+bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull,
+                         const HullOptions& options);
+
+// Hull of a point stream fed in chunks. Only the current hull vertices and
+// a bounded buffer are stored; indices count positions in the whole stream,
+// and hull() matches convex_hull_indices over the concatenated input.
+class StreamingHull {
+public:
+    StreamingHull();
+    ~StreamingHull();
+    StreamingHull(StreamingHull&& other) noexcept;
+    StreamingHull& operator=(StreamingHull&& other) noexcept;
+
+    void add(const Point* pts, size_t count);
+    void add(const std::vector<Point>& pts) { add(pts.data(), pts.size()); }
+    void clear();
+
+    int64_t size() const;
+    bool hull(std::vector<int64_t>* indices, std::vector<Point>* points = nullptr);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// Hull of a point set under insertion, removal and moves in polylogarithmic
+// time per update; hull() returns the same vertices as convex_hull_indices
+// over points().
+class DynamicHull {
+public:
+    DynamicHull();
+    explicit DynamicHull(const std::vector<Point>& pts);
+    ~DynamicHull();
+    DynamicHull(DynamicHull&& other) noexcept;
+    DynamicHull& operator=(DynamicHull&& other) noexcept;
+
+    int  insert(const Point& p);
+    // The last point takes over `index`, so indices stay dense.
+    bool remove(int index);
+    bool move(int index, const Point& p);
+    void clear();
+
+    const std::vector<Point>& points() const;
+    size_t size() const;
+    bool hull(HullIndices* out) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 } 
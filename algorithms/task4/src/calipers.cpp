@@ -0,0 +1,246 @@
+#include "task4/calipers.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/parallel.hpp"
+
+namespace task4 {
+namespace {
+struct Vec {
+    long double x = 0.0L;
+    long double y = 0.0L;
+};
+
+inline Vec sub(const Point& a, const Point& b) { return Vec{a.x - b.x, a.y - b.y}; }
+inline long double dot(const Vec& a, const Vec& b) { return a.x * b.x + a.y * b.y; }
+inline long double cross(const Vec& a, const Vec& b) { return a.x * b.y - a.y * b.x; }
+
+inline long double dist2(const Point& a, const Point& b) {
+    const Vec d = sub(a, b);
+    return dot(d, d);
+}
+
+// Hull vertex access with wrap-around.
+struct Ring {
+    const std::vector<Point>& pts;
+    const HullIndices& hull;
+    int h;
+
+    int wrap(int k) const {
+        while (k >= h) k -= h;
+        return k;
+    }
+    int id(int k) const { return hull[wrap(k)]; }
+    const Point& at(int k) const { return pts[hull[wrap(k)]]; }
+    // Twice the area of triangle (edge i, vertex k).
+    long double area(int i, int k) const {
+        return cross(sub(at(i + 1), at(i)), sub(at(k), at(i)));
+    }
+};
+
+PointPair pair_of(const Ring& r, int a, int b) {
+    return PointPair{r.id(a), r.id(b), std::sqrt(dist2(r.at(a), r.at(b)))};
+}
+
+// For every edge i, `visit(i, j)` gets the vertex j farthest from it; j
+// only moves forward, so the whole walk is O(h). Needs h >= 3.
+template <class Visit>
+void antipodal_walk(const Ring& r, Visit&& visit) {
+    int j = 1;
+    for (int i = 0; i < r.h; ++i) {
+        if (j <= i) j = i + 1;
+        while (r.area(i, j + 1) > r.area(i, j)) ++j;
+        visit(i, j);
+    }
+}
+
+bool diameter(const Ring& r, PointPair* out) {
+    if (r.h <= 2) {
+        *out = pair_of(r, 0, r.h - 1);
+        return true;
+    }
+    int best_a = 0, best_b = 1;
+    long double best = dist2(r.at(0), r.at(1));
+    antipodal_walk(r, [&](int i, int j) {
+        for (int a : {i, i + 1}) {
+            const long double d = dist2(r.at(a), r.at(j));
+            if (d > best) {
+                best = d;
+                best_a = a;
+                best_b = j;
+            }
+        }
+    });
+    *out = pair_of(r, best_a, best_b);
+    return true;
+}
+
+bool width(const Ring& r, HullWidth* out) {
+    if (r.h <= 2) {
+        *out = HullWidth{r.id(0), r.id(r.h - 1), r.id(0), 0.0L};
+        return true;
+    }
+    // Compares squared widths, area^2 / |e|^2, to stay free of roots.
+    int best_i = 0, best_j = 0;
+    long double best = -1.0L;
+    antipodal_walk(r, [&](int i, int j) {
+        const long double a = r.area(i, j);
+        const long double w = a * a / dist2(r.at(i + 1), r.at(i));
+        if (best < 0.0L || w < best) {
+            best = w;
+            best_i = i;
+            best_j = j;
+        }
+    });
+    *out = HullWidth{r.id(best_i), r.id(best_i + 1), r.id(best_j), std::sqrt(best)};
+    return true;
+}
+
+// Rectangle flush with each edge in turn; the far, right and left
+// supports advance monotonically like the antipodal vertex. Projections
+// use the unnormalised edge, so the area is scaled by |e|^2 until the end.
+bool rect(const Ring& r, BoundingRect* out) {
+    if (r.h <= 2) {
+        const Point& a = r.at(0);
+        const Point& b = r.at(r.h - 1);
+        *out = BoundingRect{{a, b, b, a}, 0.0L};
+        return true;
+    }
+
+    int right = 1, top = 1, left = 1;
+    int best_i = -1;
+    long double best = 0.0L, best_lo = 0.0L, best_hi = 0.0L, best_ht = 0.0L;
+    for (int i = 0; i < r.h; ++i) {
+        const Point& o = r.at(i);
+        const Vec e = sub(r.at(i + 1), o);
+        const Vec n{-e.y, e.x};
+        auto along = [&](int k) { return dot(sub(r.at(k), o), e); };
+        auto up = [&](int k) { return dot(sub(r.at(k), o), n); };
+
+        if (right <= i) right = i + 1;
+        while (along(right + 1) > along(right)) ++right;
+        if (top < right) top = right;
+        while (up(top + 1) > up(top)) ++top;
+        if (left < top) left = top;
+        while (along(left + 1) < along(left)) ++left;
+
+        const long double lo = along(left), hi = along(right), ht = up(top);
+        const long double area = (hi - lo) * ht / dot(e, e);
+        if (best_i < 0 || area < best) {
+            best = area;
+            best_i = i;
+            best_lo = lo;
+            best_hi = hi;
+            best_ht = ht;
+        }
+    }
+
+    const Point& o = r.at(best_i);
+    const Vec e = sub(r.at(best_i + 1), o);
+    const long double len2 = dot(e, e);
+    auto corner = [&](long double s, long double t) {
+        s /= len2;
+        t /= len2;
+        return Point{static_cast<double>(o.x + e.x * s - e.y * t),
+                     static_cast<double>(o.y + e.y * s + e.x * t)};
+    };
+    *out = BoundingRect{{corner(best_lo, 0.0L), corner(best_hi, 0.0L),
+                         corner(best_hi, best_ht), corner(best_lo, best_ht)}, best};
+    return true;
+}
+
+bool pairs(const Ring& r, std::vector<PointPair>* out) {
+    if (r.h <= 2) {
+        out->push_back(pair_of(r, 0, r.h - 1));
+        return true;
+    }
+
+    // With parallel edges the vertex after j is antipodal to edge i too.
+    antipodal_walk(r, [&](int i, int j) {
+        out->push_back(pair_of(r, i, j));
+        out->push_back(pair_of(r, i + 1, j));
+        if (r.area(i, j + 1) == r.area(i, j)) out->push_back(pair_of(r, i, j + 1));
+    });
+    for (PointPair& p : *out) {
+        if (p.first > p.second) std::swap(p.first, p.second);
+    }
+    std::sort(out->begin(), out->end(), [](const PointPair& a, const PointPair& b) {
+        if (a.distance != b.distance) return a.distance > b.distance;
+        if (a.first != b.first) return a.first < b.first;
+        return a.second < b.second;
+    });
+    out->erase(std::unique(out->begin(), out->end(), [](const PointPair& a, const PointPair& b) {
+        return a.first == b.first && a.second == b.second;
+    }), out->end());
+    return true;
+}
+
+template <class Result, class Query>
+void batch(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+           std::vector<Result>* out, int threads, Query query)
+{
+    constexpr size_t kBlock = 1024;
+    out->assign(hulls.size(), Result{});
+    const size_t blocks = (hulls.size() + kBlock - 1) / kBlock;
+    common::parallel_for(blocks, threads, [&](size_t b, int) {
+        const size_t to = std::min(hulls.size(), (b + 1) * kBlock);
+        for (size_t k = b * kBlock; k < to; ++k) {
+            if (hulls[k].empty()) continue;
+            query(Ring{pts, hulls[k], static_cast<int>(hulls[k].size())}, &(*out)[k]);
+        }
+    });
+}
+}
+
+bool hull_diameter(const std::vector<Point>& pts, const HullIndices& hull, PointPair* out) {
+    *out = PointPair{};
+    if (hull.empty()) return false;
+    return diameter(Ring{pts, hull, static_cast<int>(hull.size())}, out);
+}
+
+bool hull_width(const std::vector<Point>& pts, const HullIndices& hull, HullWidth* out) {
+    *out = HullWidth{};
+    if (hull.empty()) return false;
+    return width(Ring{pts, hull, static_cast<int>(hull.size())}, out);
+}
+
+bool min_area_rect(const std::vector<Point>& pts, const HullIndices& hull, BoundingRect* out) {
+    *out = BoundingRect{};
+    if (hull.empty()) return false;
+    return rect(Ring{pts, hull, static_cast<int>(hull.size())}, out);
+}
+
+bool farthest_pairs(const std::vector<Point>& pts, const HullIndices& hull,
+                    std::vector<PointPair>* out)
+{
+    out->clear();
+    if (hull.empty()) return false;
+    return pairs(Ring{pts, hull, static_cast<int>(hull.size())}, out);
+}
+
+void hull_diameters(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                    std::vector<PointPair>* out, int threads)
+{
+    batch(pts, hulls, out, threads, diameter);
+}
+
+void hull_widths(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                 std::vector<HullWidth>* out, int threads)
+{
+    batch(pts, hulls, out, threads, width);
+}
+
+void min_area_rects(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                    std::vector<BoundingRect>* out, int threads)
+{
+    batch(pts, hulls, out, threads, rect);
+}
+
+void hull_farthest_pairs(const std::vector<Point>& pts, const std::vector<HullIndices>& hulls,
+                         std::vector<std::vector<PointPair>>* out, int threads)
+{
+    batch(pts, hulls, out, threads, pairs);
+}
+
+} 
@@ -1,66 +1,158 @@
 #include "task4/convex_hull.hpp"
 
 #include <algorithm>
+#include <cstring>
+
+#include "common/hull_filter.hpp"
+#include "common/parallel.hpp"
+#include "common/predicates.hpp"
 
 namespace task4 {
 namespace {
-inline long double cross(const Point& a, const Point& b, const Point& c) {
-    return (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x);
+struct Item {
+    double x = 0.0;
+    double y = 0.0;
+    int id = -1;
+};
+
+inline bool item_less(const Item& a, const Item& b) {
+    if (a.x != b.x) return a.x < b.x;
+    if (a.y != b.y) return a.y < b.y;
+    return a.id < b.id;
 }
+
+common::ExtremeOctagon octagon(const std::vector<Point>& pts, int from, int to) {
+    common::ExtremeOctagon oct;
+    for (int i = from; i < to; ++i) {
+        oct.add(pts[i].x, pts[i].y);
+    }
+    return oct;
 }
 
-bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull) {
-    hull->clear();
-    const int n = static_cast<int>(pts.size());
-    if (n == 0) return false;
+void load(const std::vector<Point>& pts, int from, int to,
+          const common::ExtremeOctagon& oct, std::vector<Item>* items)
+{
+    items->clear();
+    for (int i = from; i < to; ++i) {
+        const Point& p = pts[i];
+        if (!oct.inside(p.x, p.y)) items->push_back(Item{p.x, p.y, i});
+    }
+}
 
-    std::vector<int> idx(n);
-    for (int i=0;i<n;++i) idx[i] = i;
+// Order-preserving encoding: unsigned comparison of the keys matches `<` on
+// the doubles, with -0.0 folded onto +0.0.
+inline uint64_t order_key(double v) {
+    if (v == 0.0) v = 0.0;
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    constexpr uint64_t kSign = uint64_t(1) << 63;
+    return (bits & kSign) ? ~bits : (bits | kSign);
+}
 
-    std::sort(idx.begin(), idx.end(), [&](int i, int j){
-        if (pts[i].x < pts[j].x) return true;
-        if (pts[i].x > pts[j].x) return false;
-        return pts[i].y < pts[j].y;
-    });
+// LSD radix sort on the x keys in 11-bit digits. Passes are stable, so items
+// that arrive in index order stay in index order within equal x; runs of
+// equal x are then finished by (y, index). Digits that are equal across all
+// items (typically the sign and exponent bits) are skipped.
+void radix_sort(std::vector<Item>& items, std::vector<Item>* tmp,
+                std::vector<uint32_t>* counts)
+{
+    constexpr int kBits = 11;
+    constexpr int kDigits = 6;
+    constexpr size_t kRadix = size_t(1) << kBits;
+    const size_t n = items.size();
+    if (n < 2) return;
 
-    std::vector<int> uniq;
-    uniq.reserve(n);
-    uniq.push_back(idx[0]);
-    for (int k=1;k<n;++k) {
-        int i = idx[k];
-        int j = uniq.back();
-        if (pts[i].x == pts[j].x && pts[i].y == pts[j].y) continue;
-        uniq.push_back(i);
+    std::vector<uint32_t>& hist = *counts;
+    hist.assign(kDigits * kRadix, 0);
+    for (const Item& it : items) {
+        const uint64_t key = order_key(it.x);
+        uint32_t* h = hist.data();
+        for (int d = 0; d < kDigits; ++d, h += kRadix) {
+            ++h[(key >> (d * kBits)) & (kRadix - 1)];
+        }
     }
 
-    if (static_cast<int>(uniq.size()) == 1) {
-        hull->push_back(uniq[0]);
-        return true;
+    tmp->resize(n);
+    std::vector<Item>* src = &items;
+    std::vector<Item>* dst = tmp;
+    const uint64_t first = order_key(items[0].x);
+    for (int d = 0; d < kDigits; ++d) {
+        uint32_t* h = hist.data() + d * kRadix;
+        const int shift = d * kBits;
+        if (h[(first >> shift) & (kRadix - 1)] == n) continue;
+
+        uint32_t sum = 0;
+        for (size_t b = 0; b < kRadix; ++b) {
+            const uint32_t c = h[b];
+            h[b] = sum;
+            sum += c;
+        }
+        for (const Item& it : *src) {
+            (*dst)[h[(order_key(it.x) >> shift) & (kRadix - 1)]++] = it;
+        }
+        std::swap(src, dst);
+    }
+    if (src != &items) items.swap(*tmp);
+
+    for (size_t i = 0; i < n;) {
+        size_t j = i + 1;
+        while (j < n && items[j].x == items[i].x) ++j;
+        if (j - i > 1) std::sort(items.begin() + i, items.begin() + j, item_less);
+        i = j;
+    }
+}
+
+struct SortBuffers {
+    std::vector<Item> tmp;
+    std::vector<uint32_t> counts;
+    std::vector<int> stack;
+};
+
+void sort_items(std::vector<Item>& items, bool radix, SortBuffers* buf) {
+    constexpr size_t kMinRadix = 256;
+    if (radix && items.size() >= kMinRadix) {
+        radix_sort(items, &buf->tmp, &buf->counts);
+    } else {
+        std::sort(items.begin(), items.end(), item_less);
     }
+}
 
-    std::vector<int> st;
-    st.reserve(uniq.size()*2);
+// `s` must be sorted by item_less. Among equal points the lowest index wins,
+// which keeps the chunked and serial hulls identical. Duplicates are
+// squeezed out by the lower pass itself, so `s` is only walked twice.
+void monotone_chain(std::vector<Item>& s, HullIndices* hull, std::vector<int>* stack) {
+    hull->clear();
+    std::vector<int>& st = *stack;
+    st.clear();
+    if (s.empty()) return;
 
     auto crossIdx = [&](int i, int j, int k){
-        return cross(pts[i], pts[j], pts[k]);
+        return common::orient2d(s[i], s[j], s[k]);
     };
 
-    for (int id : uniq) {
+    int m = 0;
+    for (size_t k = 0; k < s.size(); ++k) {
+        if (m > 0 && s[k].x == s[m-1].x && s[k].y == s[m-1].y) continue;
+        s[m] = s[k];
         while (st.size() >= 2) {
             int k2 = st.back(); st.pop_back();
             int k1 = st.back();
-            if (crossIdx(k1, k2, id) > 0.0L) { st.push_back(k2); break; }
+            if (crossIdx(k1, k2, m) > 0.0) { st.push_back(k2); break; }
         }
-        st.push_back(id);
+        st.push_back(m++);
+    }
+    s.resize(static_cast<size_t>(m));
+    if (m == 1) {
+        hull->push_back(s[0].id);
+        return;
     }
 
     const size_t lower_size = st.size();
-    for (int t = static_cast<int>(uniq.size()) - 2; t >= 0; --t) {
-        int id = uniq[t];
+    for (int id = m - 2; id >= 0; --id) {
         while (st.size() > lower_size) {
             int k2 = st.back(); st.pop_back();
             int k1 = st.back();
-            if (crossIdx(k1, k2, id) > 0.0L) { st.push_back(k2); break; }
+            if (crossIdx(k1, k2, id) > 0.0) { st.push_back(k2); break; }
         }
         st.push_back(id);
     }
@@ -68,12 +160,312 @@ bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull) {
     if (!st.empty()) st.pop_back();
 
     if (st.empty()) {
-        hull->push_back(uniq.front());
-        if (uniq.back() != uniq.front()) hull->push_back(uniq.back());
+        hull->push_back(s.front().id);
+        if (m > 1) hull->push_back(s.back().id);
     } else {
-        *hull = std::move(st);
+        hull->reserve(st.size());
+        for (int k : st) hull->push_back(s[k].id);
+    }
+}
+
+inline bool coord_less(const Item& a, const Item& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Both monotone_chain passes of every group of `group` consecutive items,
+// stored back to back: group g owns lower[lower_at[g], lower_at[g+1]) and
+// likewise for upper.
+struct GroupChains {
+    std::vector<Item> lower, upper;
+    std::vector<size_t> lower_at, upper_at;
+};
+
+template <class It>
+void append_chain(It first, It last, std::vector<Item>* out) {
+    const size_t base = out->size();
+    for (It it = first; it != last; ++it) {
+        while (out->size() >= base + 2 &&
+               common::orient2d((*out)[out->size() - 2], out->back(), *it) <= 0.0) {
+            out->pop_back();
+        }
+        out->push_back(*it);
+    }
+}
+
+void group_chains(std::vector<Item>& items, size_t group, GroupChains* g) {
+    g->lower.clear();
+    g->upper.clear();
+    g->lower_at.assign(1, 0);
+    g->upper_at.assign(1, 0);
+    std::vector<Item> uniq;
+    for (size_t from = 0; from < items.size(); from += group) {
+        const size_t to = std::min(items.size(), from + group);
+        std::sort(items.begin() + from, items.begin() + to, item_less);
+        uniq.clear();
+        for (size_t k = from; k < to; ++k) {
+            if (uniq.empty() || coord_less(uniq.back(), items[k])) uniq.push_back(items[k]);
+        }
+        append_chain(uniq.begin(), uniq.end(), &g->lower);
+        append_chain(uniq.rbegin(), uniq.rend(), &g->upper);
+        g->lower_at.push_back(g->lower.size());
+        g->upper_at.push_back(g->upper.size());
+    }
+}
+
+// Jarvis march over the group chains from `start` until no group has a
+// vertex past the current one in walk order (`ahead(a, b)`: a comes before
+// b). Each group offers the tangent point of its chain suffix, found by
+// the same pop rule as monotone_chain; collinear candidates go to the
+// farther one and equal points to the lower index. Gives up after `limit`
+// vertices.
+template <class Ahead>
+bool wrap(const std::vector<Item>& verts, const std::vector<size_t>& at,
+          const Item& start, Ahead ahead, size_t limit, std::vector<Item>* out)
+{
+    out->assign(1, start);
+    Item p = start;
+    for (;;) {
+        bool found = false;
+        Item best;
+        for (size_t g = 0; g + 1 < at.size(); ++g) {
+            const Item* b = verts.data() + at[g];
+            const Item* e = verts.data() + at[g + 1];
+            const Item* s = std::partition_point(b, e, [&](const Item& v) {
+                return !ahead(p, v);
+            });
+            if (s == e) continue;
+
+            size_t lo = 0, hi = static_cast<size_t>(e - s) - 1;
+            while (lo < hi) {
+                const size_t mid = (lo + hi) / 2;
+                if (common::orient2d(p, s[mid], s[mid + 1]) > 0.0) hi = mid;
+                else lo = mid + 1;
+            }
+            const Item& c = s[lo];
+            if (!found) {
+                best = c;
+                found = true;
+                continue;
+            }
+            const double o = common::orient2d(p, best, c);
+            if (o < 0.0 || (o == 0.0 && (ahead(best, c) ||
+                                         (!ahead(c, best) && c.id < best.id)))) {
+                best = c;
+            }
+        }
+        if (!found) return true;
+        if (out->size() >= limit) return false;
+        out->push_back(best);
+        p = best;
+    }
+}
+
+// Hull size of an evenly strided sample, as a cheap proxy for h.
+size_t sampled_hull(const std::vector<Item>& items) {
+    constexpr size_t kSamples = 1024;
+    std::vector<Item> sample;
+    const size_t stride = std::max<size_t>(1, items.size() / kSamples);
+    for (size_t k = 0; k < items.size(); k += stride) sample.push_back(items[k]);
+    std::sort(sample.begin(), sample.end(), item_less);
+    HullIndices h;
+    std::vector<int> stack;
+    monotone_chain(sample, &h, &stack);
+    return h.size();
+}
+
+// Chan's algorithm: hulls groups of H items and wraps them with O(log H)
+// tangent searches per group, squaring H until the wrap fits in H vertices,
+// for O(n log h) overall. The first H comes from `estimate` (a sampled hull
+// size) instead of 4, which saves the failed rounds on typical inputs.
+void chan(std::vector<Item>& items, size_t estimate, HullIndices* hull) {
+    hull->clear();
+    const size_t n = items.size();
+    if (n == 0) return;
+
+    Item first = items[0], last = items[0];
+    for (const Item& it : items) {
+        if (item_less(it, first)) first = it;
+        if (coord_less(last, it) || (!coord_less(it, last) && it.id < last.id)) last = it;
     }
+
+    auto forward = [](const Item& a, const Item& b) { return coord_less(a, b); };
+    auto backward = [](const Item& a, const Item& b) { return coord_less(b, a); };
+
+    size_t group = 16;
+    while (group < 8 * estimate) group *= 2;
+
+    GroupChains g;
+    std::vector<Item> lower, upper;
+    for (;; group = group > (size_t(1) << 16) ? n : group * group) {
+        group = std::min(group, n);
+        const size_t limit = group >= n ? n + 1 : group;
+        group_chains(items, group, &g);
+        if (wrap(g.lower, g.lower_at, first, forward, limit, &lower) &&
+            wrap(g.upper, g.upper_at, last, backward, limit, &upper)) {
+            break;
+        }
+    }
+
+    hull->reserve(lower.size() + upper.size());
+    for (const Item& v : lower) hull->push_back(v.id);
+    for (size_t k = 1; k + 1 < upper.size(); ++k) hull->push_back(upper[k].id);
+}
+}
+
+struct HullScratch::Impl {
+    std::vector<Item> items;
+    SortBuffers buf;
+};
+
+HullScratch::HullScratch() : impl_(std::make_unique<Impl>()) {}
+HullScratch::~HullScratch() = default;
+HullScratch::HullScratch(HullScratch&& other) noexcept = default;
+HullScratch& HullScratch::operator=(HullScratch&& other) noexcept = default;
+
+bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull) {
+    return convex_hull_indices(pts, hull, HullOptions{});
+}
+
+bool convex_hull_indices(const std::vector<Point>& pts, HullIndices* hull,
+                         const HullOptions& options)
+{
+    hull->clear();
+    const int n = static_cast<int>(pts.size());
+    if (n == 0) return false;
+
+    constexpr int kMinChunk = 1 << 16;
+    constexpr size_t kChanMinItems = size_t(1) << 15;
+    constexpr size_t kChanMaxSampledHull = 24;
+    const int workers = common::resolve_threads(options.threads);
+    const int chunks = std::min(workers, n / kMinChunk);
+    HullScratch::Impl own;
+    HullScratch::Impl& scratch = options.scratch ? options.scratch->impl() : own;
+    std::vector<Item>& items = scratch.items;
+
+    if (chunks < 2) {
+        common::ExtremeOctagon oct = octagon(pts, 0, n);
+        oct.close();
+        load(pts, 0, n, oct, &items);
+        if (options.algorithm != HullAlgorithm::MonotoneChain &&
+            (options.algorithm == HullAlgorithm::Chan || items.size() >= kChanMinItems))
+        {
+            const size_t estimate = sampled_hull(items);
+            if (options.algorithm == HullAlgorithm::Chan || estimate <= kChanMaxSampledHull) {
+                chan(items, estimate, hull);
+                return !hull->empty();
+            }
+        }
+        sort_items(items, options.radix, &scratch.buf);
+        monotone_chain(items, hull, &scratch.buf.stack);
+        return !hull->empty();
+    }
+
+    auto bound = [&](size_t c) {
+        return static_cast<int>(static_cast<long long>(n) * c / chunks);
+    };
+    std::vector<common::ExtremeOctagon> octs(chunks);
+    common::parallel_for(chunks, workers, [&](size_t c, int) {
+        octs[c] = octagon(pts, bound(c), bound(c + 1));
+    });
+    common::ExtremeOctagon oct;
+    for (const auto& o : octs) oct.merge(o);
+    oct.close();
+
+    std::vector<HullIndices> parts(chunks);
+    common::parallel_for(chunks, workers, [&](size_t c, int) {
+        std::vector<Item> local;
+        SortBuffers buf;
+        load(pts, bound(c), bound(c + 1), oct, &local);
+        sort_items(local, options.radix, &buf);
+        monotone_chain(local, &parts[c], &buf.stack);
+    });
+
+    items.clear();
+    for (const auto& part : parts) {
+        for (int i : part) {
+            items.push_back(Item{pts[i].x, pts[i].y, i});
+        }
+    }
+    sort_items(items, options.radix, &scratch.buf);
+    monotone_chain(items, hull, &scratch.buf.stack);
     return !hull->empty();
 }
 
+struct StreamingHull::Impl {
+    static constexpr size_t kBuffer = size_t(1) << 16;
+
+    struct Vertex {
+        Point p;
+        int64_t id;
+    };
+
+    std::vector<Vertex> kept;
+    std::vector<Vertex> buffer;
+    common::ExtremeOctagon oct;
+    int64_t seen = 0;
+
+    void flush() {
+        if (buffer.empty()) return;
+        std::vector<Vertex> all;
+        all.reserve(kept.size() + buffer.size());
+        all.assign(kept.begin(), kept.end());
+        std::sort(all.begin(), all.end(), [](const Vertex& a, const Vertex& b) {
+            return a.id < b.id;
+        });
+        all.insert(all.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+
+        std::vector<Item> items(all.size());
+        for (size_t k = 0; k < all.size(); ++k) {
+            items[k] = Item{all[k].p.x, all[k].p.y, static_cast<int>(k)};
+        }
+        std::sort(items.begin(), items.end(), item_less);
+        HullIndices local;
+        std::vector<int> stack;
+        monotone_chain(items, &local, &stack);
+
+        kept.clear();
+        oct = common::ExtremeOctagon();
+        for (int k : local) {
+            kept.push_back(all[k]);
+            oct.add(all[k].p.x, all[k].p.y);
+        }
+        oct.close();
+    }
+};
+
+StreamingHull::StreamingHull() : impl_(std::make_unique<Impl>()) {}
+StreamingHull::~StreamingHull() = default;
+StreamingHull::StreamingHull(StreamingHull&& other) noexcept = default;
+StreamingHull& StreamingHull::operator=(StreamingHull&& other) noexcept = default;
+
+void StreamingHull::add(const Point* pts, size_t count) {
+    Impl& m = *impl_;
+    for (size_t i = 0; i < count; ++i, ++m.seen) {
+        if (m.oct.inside(pts[i].x, pts[i].y)) continue;
+        m.buffer.push_back(Impl::Vertex{pts[i], m.seen});
+        if (m.buffer.size() >= std::max(Impl::kBuffer, m.kept.size())) m.flush();
+    }
+}
+
+void StreamingHull::clear() {
+    impl_ = std::make_unique<Impl>();
+}
+
+int64_t StreamingHull::size() const {
+    return impl_->seen;
+}
+
+bool StreamingHull::hull(std::vector<int64_t>* indices, std::vector<Point>* points) {
+    Impl& m = *impl_;
+    m.flush();
+    indices->clear();
+    if (points) points->clear();
+    for (const auto& v : m.kept) {
+        indices->push_back(v.id);
+        if (points) points->push_back(v.p);
+    }
+    return !indices->empty();
+}
+
 } 
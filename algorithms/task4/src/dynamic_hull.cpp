@@ -0,0 +1,326 @@
+#include "task4/convex_hull.hpp"
+
+#include <algorithm>
+
+#include "common/predicates.hpp"
+
+namespace task4 {
+namespace {
+struct Key {
+    double x = 0.0;
+    double y = 0.0;
+    int id = -1;
+};
+
+inline bool key_less(const Key& a, const Key& b) {
+    if (a.x != b.x) return a.x < b.x;
+    if (a.y != b.y) return a.y < b.y;
+    return a.id < b.id;
+}
+
+inline bool same_point(const Key& a, const Key& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+Key make_key(const Point& p, int id) {
+    return Key{p.x, p.y, id};
+}
+
+// One pass of Andrew's chain: keeps strict left turns only, like
+// monotone_chain in convex_hull.cpp.
+template <class It>
+void chain(It first, It last, std::vector<Key>* out) {
+    out->clear();
+    for (It it = first; it != last; ++it) {
+        while (out->size() >= 2 &&
+               common::orient2d((*out)[out->size() - 2], out->back(), *it) <= 0.0) {
+            out->pop_back();
+        }
+        out->push_back(*it);
+    }
+}
+}
+
+// Points sorted by (x, y, index) are cut into buckets with explicit chains;
+// a balanced tree over the buckets stores, per node and per chain, only how
+// many vertices it keeps from each child. Chain 0 is the lower hull walked
+// left to right, chain 1 the upper hull walked right to left, i.e. the two
+// passes of monotone_chain. A point update rebuilds one bucket and the
+// bridges on its root path: O(B + log^3 n).
+struct DynamicHull::Impl {
+    static constexpr size_t kBucket = 128;
+
+    struct Bucket {
+        std::vector<Key> items;
+        std::vector<Key> chain[2];
+    };
+
+    struct Node {
+        int take[2] = {0, 0};
+        int skip[2] = {0, 0};
+        int count[2] = {0, 0};
+    };
+
+    std::vector<Point> pts;
+    std::vector<Bucket> buckets;
+    std::vector<Node> tree;
+    int leaves = 1;
+
+    static void refresh(Bucket& b) {
+        std::vector<Key> uniq;
+        uniq.reserve(b.items.size());
+        for (const Key& k : b.items) {
+            if (uniq.empty() || !same_point(uniq.back(), k)) uniq.push_back(k);
+        }
+        chain(uniq.begin(), uniq.end(), &b.chain[0]);
+        chain(uniq.rbegin(), uniq.rend(), &b.chain[1]);
+    }
+
+    int size(int v, int d) const {
+        if (v < leaves) return tree[v].count[d];
+        const size_t b = static_cast<size_t>(v - leaves);
+        return b < buckets.size() ? static_cast<int>(buckets[b].chain[d].size()) : 0;
+    }
+
+    // Chain 0 runs left child first, chain 1 right child first.
+    static int first_child(int v, int d) { return d == 0 ? 2*v : 2*v + 1; }
+    static int second_child(int v, int d) { return d == 0 ? 2*v + 1 : 2*v; }
+
+    const Key& at(int v, int d, int k) const {
+        while (v < leaves) {
+            const Node& n = tree[v];
+            if (k < n.take[d]) {
+                v = first_child(v, d);
+            } else {
+                k += n.skip[d] - n.take[d];
+                v = second_child(v, d);
+            }
+        }
+        return buckets[v - leaves].chain[d][k];
+    }
+
+    // Bridge between the chains P (first child) and Q (second child): the
+    // merged chain is P[0, take) followed by Q[skip, |Q|). Both searches
+    // replay the pops the single pass would do, so collinear points are
+    // dropped the same way.
+    void bridge(int v, int d) {
+        Node& n = tree[v];
+        const int f = first_child(v, d), s = second_child(v, d);
+        const int a = size(f, d), b = size(s, d);
+        if (a == 0 || b == 0) {
+            n.take[d] = a;
+            n.skip[d] = 0;
+            n.count[d] = a + b;
+            return;
+        }
+
+        auto kept = [&](const Key& q) {
+            int lo = 1, hi = a - 1, best = 0;
+            while (lo <= hi) {
+                const int mid = (lo + hi) / 2;
+                if (common::orient2d(at(f, d, mid - 1), at(f, d, mid), q) > 0.0) {
+                    best = mid;
+                    lo = mid + 1;
+                } else {
+                    hi = mid - 1;
+                }
+            }
+            return best + 1;
+        };
+
+        int lo = 0, hi = b - 1;
+        while (lo < hi) {
+            const int mid = (lo + hi) / 2;
+            const Key& q = at(s, d, mid);
+            const int t = kept(q);
+            if (common::orient2d(at(f, d, t - 1), q, at(s, d, mid + 1)) > 0.0) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        n.take[d] = kept(at(s, d, lo));
+        n.skip[d] = lo;
+        n.count[d] = n.take[d] + b - lo;
+    }
+
+    void update(int v) {
+        bridge(v, 0);
+        bridge(v, 1);
+    }
+
+    void rebuild_tree() {
+        leaves = 1;
+        while (leaves < static_cast<int>(buckets.size())) leaves *= 2;
+        tree.assign(static_cast<size_t>(leaves), Node{});
+        for (int v = leaves - 1; v >= 1; --v) update(v);
+    }
+
+    void touched(size_t b) {
+        for (int v = (leaves + static_cast<int>(b)) / 2; v >= 1; v /= 2) update(v);
+    }
+
+    size_t locate(const Key& k) const {
+        auto it = std::partition_point(buckets.begin(), buckets.end(),
+            [&](const Bucket& b) {
+                const Key& e = b.items.back();
+                return e.x < k.x || (e.x == k.x && e.y < k.y);
+            });
+        if (it == buckets.end()) --it;
+        return static_cast<size_t>(it - buckets.begin());
+    }
+
+    // Splits never separate equal points, so buckets never share a point and
+    // the bridges only have to deal with collinear vertices.
+    bool split(size_t b) {
+        std::vector<Key>& items = buckets[b].items;
+        const size_t half = items.size() / 2;
+        size_t cut = 0;
+        for (size_t k = half; k < items.size() && cut == 0; ++k) {
+            if (!same_point(items[k - 1], items[k])) cut = k;
+        }
+        for (size_t k = half; k > 1 && cut == 0; --k) {
+            if (!same_point(items[k - 2], items[k - 1])) cut = k - 1;
+        }
+        if (cut == 0) return false;
+
+        Bucket tail;
+        tail.items.assign(items.begin() + static_cast<std::ptrdiff_t>(cut), items.end());
+        items.resize(cut);
+        refresh(buckets[b]);
+        refresh(tail);
+        buckets.insert(buckets.begin() + static_cast<std::ptrdiff_t>(b) + 1, std::move(tail));
+        return true;
+    }
+
+    void attach(int id) {
+        const Key k = make_key(pts[id], id);
+        if (buckets.empty()) {
+            buckets.emplace_back();
+            buckets.back().items.push_back(k);
+            refresh(buckets.back());
+            rebuild_tree();
+            return;
+        }
+        const size_t b = locate(k);
+        std::vector<Key>& items = buckets[b].items;
+        items.insert(std::upper_bound(items.begin(), items.end(), k, key_less), k);
+        refresh(buckets[b]);
+        if (items.size() > 2*kBucket && split(b)) {
+            rebuild_tree();
+        } else {
+            touched(b);
+        }
+    }
+
+    void detach(int id) {
+        const Key k = make_key(pts[id], id);
+        const size_t b = locate(k);
+        std::vector<Key>& items = buckets[b].items;
+        auto it = std::lower_bound(items.begin(), items.end(), k, key_less);
+        items.erase(it);
+        if (items.empty()) {
+            buckets.erase(buckets.begin() + static_cast<std::ptrdiff_t>(b));
+            rebuild_tree();
+        } else {
+            refresh(buckets[b]);
+            touched(b);
+        }
+    }
+
+    void build() {
+        std::vector<Key> all;
+        all.reserve(pts.size());
+        for (size_t i = 0; i < pts.size(); ++i) {
+            all.push_back(make_key(pts[i], static_cast<int>(i)));
+        }
+        std::sort(all.begin(), all.end(), key_less);
+
+        buckets.clear();
+        size_t from = 0;
+        while (from < all.size()) {
+            size_t to = std::min(all.size(), from + kBucket);
+            while (to < all.size() && same_point(all[to - 1], all[to])) ++to;
+            Bucket b;
+            b.items.assign(all.begin() + static_cast<std::ptrdiff_t>(from),
+                           all.begin() + static_cast<std::ptrdiff_t>(to));
+            refresh(b);
+            buckets.push_back(std::move(b));
+            from = to;
+        }
+        rebuild_tree();
+    }
+};
+
+DynamicHull::DynamicHull() : impl_(std::make_unique<Impl>()) {}
+
+DynamicHull::DynamicHull(const std::vector<Point>& pts)
+    : impl_(std::make_unique<Impl>())
+{
+    impl_->pts = pts;
+    impl_->build();
+}
+
+DynamicHull::~DynamicHull() = default;
+DynamicHull::DynamicHull(DynamicHull&& other) noexcept = default;
+DynamicHull& DynamicHull::operator=(DynamicHull&& other) noexcept = default;
+
+int DynamicHull::insert(const Point& p) {
+    Impl& h = *impl_;
+    h.pts.push_back(p);
+    const int idx = static_cast<int>(h.pts.size()) - 1;
+    h.attach(idx);
+    return idx;
+}
+
+bool DynamicHull::remove(int index) {
+    Impl& h = *impl_;
+    if (index < 0 || index >= static_cast<int>(h.pts.size())) return false;
+    h.detach(index);
+
+    const int last = static_cast<int>(h.pts.size()) - 1;
+    if (index != last) {
+        h.detach(last);
+        h.pts[index] = h.pts[last];
+        h.pts.pop_back();
+        h.attach(index);
+    } else {
+        h.pts.pop_back();
+    }
+    return true;
+}
+
+bool DynamicHull::move(int index, const Point& p) {
+    Impl& h = *impl_;
+    if (index < 0 || index >= static_cast<int>(h.pts.size())) return false;
+    h.detach(index);
+    h.pts[index] = p;
+    h.attach(index);
+    return true;
+}
+
+void DynamicHull::clear() {
+    impl_ = std::make_unique<Impl>();
+}
+
+const std::vector<Point>& DynamicHull::points() const {
+    return impl_->pts;
+}
+
+size_t DynamicHull::size() const {
+    return impl_->pts.size();
+}
+
+bool DynamicHull::hull(HullIndices* out) const {
+    const Impl& h = *impl_;
+    out->clear();
+    if (h.buckets.empty()) return false;
+
+    const int lower = h.size(1, 0), upper = h.size(1, 1);
+    out->reserve(static_cast<size_t>(lower + upper));
+    for (int k = 0; k < lower; ++k) out->push_back(h.at(1, 0, k).id);
+    for (int k = 1; k + 1 < upper; ++k) out->push_back(h.at(1, 1, k).id);
+    return !out->empty();
+}
+
+} 
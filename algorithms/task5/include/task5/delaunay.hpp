@@ -1,11 +1,12 @@
 #pragma once
+#include <memory>
 #include <vector>
 
 namespace task5 {
 
 struct Point {
-    long double x = 0.0L;
-    long double y = 0.0L;
+    double x = 0.0;
+    double y = 0.0;
 };
 
 struct Triangle {
@@ -14,7 +15,58 @@ struct Triangle {
     int c = -1;
 };
 
+struct TriangleAdjacency {
+    int ab = -1;
+    int bc = -1;
+    int ca = -1;
+};
+
+enum class InsertionOrder { AsGiven, Brio };
+
+struct DelaunayOptions {
+    InsertionOrder order = InsertionOrder::AsGiven;
+    // threads > 1 (or 0 = all cores) triangulates x-ordered strips in
+    // parallel for inputs of 16k+ points, ignoring `order`. The result
+    // matches the serial AsGiven one: the same hull, the lowest index of
+    // repeated points, and the same triangles up to the diagonals chosen
+    // among cocircular points; only the output order differs.
+    int threads = 1;
+};
+
 bool delaunay_triangulation(const std::vector<Point>& pts,
                             std::vector<Triangle>* triangles);
 
+bool delaunay_triangulation(const std::vector<Point>& pts,
+                            std::vector<Triangle>* triangles,
+                            std::vector<TriangleAdjacency>* adjacency);
+
+bool delaunay_triangulation(const std::vector<Point>& pts,
+                            std::vector<Triangle>* triangles,
+                            std::vector<TriangleAdjacency>* adjacency,
+                            const DelaunayOptions& options);
+
+class DelaunayMesh {
+public:
+    DelaunayMesh();
+    explicit DelaunayMesh(const std::vector<Point>& pts);
+    ~DelaunayMesh();
+    DelaunayMesh(DelaunayMesh&& other) noexcept;
+    DelaunayMesh& operator=(DelaunayMesh&& other) noexcept;
+
+    int  insert(const Point& p);
+    // The last point takes over `index`, so indices stay dense.
+    bool remove(int index);
+    bool move(int index, const Point& p);
+    void clear();
+
+    const std::vector<Point>& points() const;
+    size_t size() const;
+    void triangles(std::vector<Triangle>* out,
+                   std::vector<TriangleAdjacency>* adjacency = nullptr) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 } 
@@ -1,46 +1,436 @@
 #include "task5/delaunay.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <numeric>
+#include <unordered_set>
+#include <utility>
+
+#include "common/parallel.hpp"
+#include "common/predicates.hpp"
 
 namespace task5 {
 namespace {
-inline long double orient(const Point& a, const Point& b, const Point& c) {
-    return (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x);
+struct Vec {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+inline Vec to_vec(const Point& p) {
+    return Vec{p.x, p.y};
 }
 
-bool in_circumcircle(const Point& A, const Point& B, const Point& C,
-                     const Point& P)
-{
-    const long double ax = A.x - P.x, ay = A.y - P.y;
-    const long double bx = B.x - P.x, by = B.y - P.y;
-    const long double cx = C.x - P.x, cy = C.y - P.y;
+inline double orient(const Vec& a, const Vec& b, const Vec& c) {
+    return common::orient2d(a, b, c);
+}
 
-    const long double a2 = ax*ax + ay*ay;
-    const long double b2 = bx*bx + by*by;
-    const long double c2 = cx*cx + cy*cy;
+inline bool in_circumcircle(const Vec& A, const Vec& B, const Vec& C, const Vec& P) {
+    return common::incircle(A, B, C, P) > 0.0;
+}
+
+inline bool outside_circumcircle(const Vec& A, const Vec& B, const Vec& C, const Vec& P) {
+    return common::incircle(A, B, C, P) < 0.0;
+}
 
-    const long double det =
-        a2 * (bx*cy - by*cx) -
-        b2 * (ax*cy - ay*cx) +
-        c2 * (ax*by - ay*bx);
+struct Circle {
+    double x = 0.0;
+    double y = 0.0;
+    double r = 0.0;
+};
 
-    const long double orientABC = orient(A, B, C);
-    const long double s = (orientABC > 0.0L) ? 1.0L : (orientABC < 0.0L ? -1.0L : 0.0L);
-    const long double eps = 1e-18L;
-    return (det * s) > eps;
+Circle circumcircle(const Vec& A, const Vec& B, const Vec& C) {
+    const double bx = B.x - A.x, by = B.y - A.y;
+    const double cx = C.x - A.x, cy = C.y - A.y;
+    const double d = 2.0 * (bx*cy - by*cx);
+    const double b2 = bx*bx + by*by;
+    const double c2 = cx*cx + cy*cy;
+    const double ux = (cy*b2 - by*c2) / d;
+    const double uy = (bx*c2 - cx*b2) / d;
+    return Circle{A.x + ux, A.y + uy, std::sqrt(ux*ux + uy*uy)};
 }
+
+constexpr int kSuper = 3;
+
+struct Tri {
+    int v[3];
+    int n[3];
+};
+
+using Frame = std::array<Vec, kSuper>;
+
+// Super triangle around the bounding box of pts, scaled by margin.
+Frame super_triangle(const std::vector<Point>& pts, double margin) {
+    double minx = std::numeric_limits<double>::infinity();
+    double miny = std::numeric_limits<double>::infinity();
+    double maxx = -minx;
+    double maxy = -miny;
+    for (const auto& p : pts) {
+        if (p.x < minx) minx = p.x;
+        if (p.x > maxx) maxx = p.x;
+        if (p.y < miny) miny = p.y;
+        if (p.y > maxy) maxy = p.y;
+    }
+    if (pts.empty()) minx = maxx = miny = maxy = 0.0;
+
+    const double dx = maxx - minx;
+    const double dy = maxy - miny;
+    const double delta = (dx > dy ? dx : dy);
+    const double cx = (minx + maxx) * 0.5;
+    const double cy = (miny + maxy) * 0.5;
+    const double R  = 4.0 * (delta + 1.0) * margin;
+    return Frame{{Vec{cx - 2.0*R, cy - R}, Vec{cx, cy + 2.0*R}, Vec{cx + 2.0*R, cy - R}}};
 }
 
-bool delaunay_triangulation(const std::vector<Point>& pts,
-                            std::vector<Triangle>* triangles)
-{
-    triangles->clear();
-    const int n = static_cast<int>(pts.size());
-    if (n < 2) return false;
-    if (n == 2) return true;
+class Triangulator {
+public:
+    Triangulator(const std::vector<Point>& pts, bool jump, double margin = 1.0)
+        : Triangulator(pts, jump, super_triangle(pts, margin)) {}
+
+    // Triangles near the hull depend on the super triangle, so pieces of one
+    // input triangulated separately share the frame of the whole input.
+    Triangulator(const std::vector<Point>& pts, bool jump, const Frame& frame)
+        : jump_(jump)
+    {
+        pts_.reserve(pts.size() + kSuper);
+        pts_.assign(frame.begin(), frame.end());
+        for (const auto& q : pts) pts_.push_back(to_vec(q));
+
+        tris_.reserve(2 * pts.size() + 1);
+        tris_.push_back(Tri{{0, 2, 1}, {-1, -1, -1}});
+        mark_.push_back(0);
+        vtri_.assign(pts_.size(), -1);
+        start_.assign(pts_.size(), -1);
+    }
+
+    int add_point(const Point& p) {
+        pts_.push_back(to_vec(p));
+        vtri_.push_back(-1);
+        start_.push_back(-1);
+        return static_cast<int>(pts_.size()) - 1;
+    }
+
+    void set_point(int v, const Point& p) { pts_[v] = to_vec(p); }
+
+    void drop_last_point() {
+        pts_.pop_back();
+        vtri_.pop_back();
+        start_.pop_back();
+    }
+
+    bool covers(const Point& q) const {
+        const Vec p = to_vec(q);
+        return orient(pts_[0], pts_[2], p) > 0.0 &&
+               orient(pts_[2], pts_[1], p) > 0.0 &&
+               orient(pts_[1], pts_[0], p) > 0.0;
+    }
+
+    bool insert(int pi) {
+        const Vec P = pts_[pi];
+        const int seed = locate(P);
+        if (!in_circle(seed, P)) return false;
+
+        ++epoch_;
+        cavity_.clear();
+        boundary_.clear();
+        cavity_.push_back(seed);
+        mark_[seed] = epoch_;
+        for (size_t k = 0; k < cavity_.size(); ++k) {
+            const Tri& T = tris_[cavity_[k]];
+            for (int i = 0; i < 3; ++i) {
+                const int nb = T.n[i];
+                if (nb < 0 || mark_[nb] == epoch_) continue;
+                const bool visible =
+                    orient(pts_[T.v[(i+1)%3]], pts_[T.v[(i+2)%3]], P) > 0.0;
+                if (!in_circle(nb, P) && visible) continue;
+                mark_[nb] = epoch_;
+                cavity_.push_back(nb);
+            }
+        }
+
+        for (int c : cavity_) {
+            const Tri& T = tris_[c];
+            for (int i = 0; i < 3; ++i) {
+                const int nb = T.n[i];
+                if (nb >= 0 && mark_[nb] == epoch_) continue;
+                boundary_.push_back(Edge{T.v[(i+1)%3], T.v[(i+2)%3], nb, slot_of(nb, c)});
+            }
+        }
+
+        created_.clear();
+        for (size_t k = 0; k < boundary_.size(); ++k) {
+            const Edge& e = boundary_[k];
+            const int id = k < cavity_.size() ? cavity_[k] : allocate();
+            tris_[id] = Tri{{e.u, e.v, pi}, {-1, -1, e.outer}};
+            if (e.outer >= 0) tris_[e.outer].n[e.slot] = id;
+            start_[e.u] = id;
+            vtri_[e.u] = id;
+            created_.push_back(id);
+        }
+        for (int id : created_) {
+            const int next = start_[tris_[id].v[1]];
+            tris_[id].n[0] = next;
+            tris_[next].n[1] = id;
+        }
+        last_ = created_.back();
+        vtri_[pi] = last_;
+        return true;
+    }
+
+    void remove(int pv) {
+        const int t0 = vtri_[pv];
+        if (t0 < 0) return;
+
+        ring_.clear();
+        star_.clear();
+        cavity_.clear();
+        int t = t0;
+        do {
+            const Tri& T = tris_[t];
+            const int i = index_in(T, pv);
+            ring_.push_back(T.v[(i+1)%3]);
+            star_.push_back(Edge{T.v[(i+1)%3], T.v[(i+2)%3], T.n[i], slot_of(T.n[i], t)});
+            cavity_.push_back(t);
+            t = T.n[(i+1)%3];
+        } while (t != t0 && t >= 0);
+
+        const int d = static_cast<int>(ring_.size());
+        ears_.clear();
+        open_.assign(ring_.begin(), ring_.end());
+        while (open_.size() > 3) {
+            const int m = static_cast<int>(open_.size());
+            int pick = -1;
+            int convex = -1;
+            for (int k = 0; k < m && pick < 0; ++k) {
+                const int a = open_[(k + m - 1) % m], b = open_[k], c = open_[(k + 1) % m];
+                if (orient(pts_[a], pts_[b], pts_[c]) <= 0.0) continue;
+                if (convex < 0) convex = k;
+                bool empty = true;
+                for (int w : ring_) {
+                    if (w == a || w == b || w == c) continue;
+                    if (in_circumcircle(pts_[a], pts_[b], pts_[c], pts_[w])) { empty = false; break; }
+                }
+                if (empty) pick = k;
+            }
+            if (pick < 0) pick = convex < 0 ? 0 : convex;
+            ears_.push_back({open_[(pick + m - 1) % m], open_[pick], open_[(pick + 1) % m]});
+            open_.erase(open_.begin() + pick);
+        }
+        ears_.push_back({open_[0], open_[1], open_[2]});
+
+        for (size_t k = 0; k < ears_.size(); ++k) {
+            const auto& e = ears_[k];
+            tris_[cavity_[k]] = Tri{{e[0], e[1], e[2]}, {-1, -1, -1}};
+        }
+        for (size_t k = ears_.size(); k < cavity_.size(); ++k) release(cavity_[k]);
+
+        auto ring_pos = [&](int w) {
+            for (int k = 0; k < d; ++k) if (ring_[k] == w) return k;
+            return -1;
+        };
+        for (size_t k = 0; k < ears_.size(); ++k) {
+            const int id = cavity_[k];
+            for (int i = 0; i < 3; ++i) {
+                const int x = tris_[id].v[(i+1)%3];
+                const int y = tris_[id].v[(i+2)%3];
+                vtri_[x] = id;
+                const int px = ring_pos(x);
+                if (ring_[(px + 1) % d] == y) {
+                    const Edge& e = star_[px];
+                    tris_[id].n[i] = e.outer;
+                    if (e.outer >= 0) tris_[e.outer].n[e.slot] = id;
+                    continue;
+                }
+                for (size_t j = 0; j < ears_.size(); ++j) {
+                    const Tri& U = tris_[cavity_[j]];
+                    const int s = index_in(U, y);
+                    if (j != k && s >= 0 && U.v[(s+1)%3] == x) {
+                        tris_[id].n[i] = cavity_[j];
+                        break;
+                    }
+                }
+            }
+        }
+        vtri_[pv] = -1;
+        last_ = cavity_[0];
+    }
+
+    void rename(int from, int to) {
+        pts_[to] = pts_[from];
+        vtri_[to] = vtri_[from];
+        const int t0 = vtri_[from];
+        if (t0 < 0) return;
+        int t = t0;
+        do {
+            Tri& T = tris_[t];
+            const int i = index_in(T, from);
+            T.v[i] = to;
+            t = T.n[(i+1)%3];
+        } while (t != t0 && t >= 0);
+    }
+
+    void collect(std::vector<Triangle>* out,
+                 std::vector<TriangleAdjacency>* adj) const
+    {
+        out->clear();
+        out->reserve(tris_.size());
+        std::vector<int> remap;
+        if (adj) remap.assign(tris_.size(), -1);
+        for (size_t t = 0; t < tris_.size(); ++t) {
+            const Tri& T = tris_[t];
+            if (!real(T)) continue;
+            if (adj) remap[t] = static_cast<int>(out->size());
+            out->push_back(Triangle{T.v[0] - kSuper, T.v[1] - kSuper, T.v[2] - kSuper});
+        }
+        if (!adj) return;
+
+        adj->clear();
+        adj->reserve(out->size());
+        for (size_t t = 0; t < tris_.size(); ++t) {
+            if (remap[t] < 0) continue;
+            const Tri& T = tris_[t];
+            auto link = [&](int nb) { return nb < 0 ? -1 : remap[nb]; };
+            adj->push_back(TriangleAdjacency{link(T.n[2]), link(T.n[0]), link(T.n[1])});
+        }
+    }
+
+    const std::vector<Tri>& mesh() const { return tris_; }
+    const Vec& point(int i) const { return pts_[i]; }
+    int points() const { return static_cast<int>(pts_.size()); }
+    bool attached(int v) const { return vtri_[v] >= 0; }
+    static bool real(const Tri& T) {
+        return T.v[0] >= kSuper && T.v[1] >= kSuper && T.v[2] >= kSuper;
+    }
+
+private:
+    struct Edge { int u, v, outer, slot; };
+
+    static int index_in(const Tri& T, int v) {
+        return T.v[0] == v ? 0 : (T.v[1] == v ? 1 : (T.v[2] == v ? 2 : -1));
+    }
+
+    int slot_of(int t, int nb) const {
+        if (t < 0) return -1;
+        for (int j = 0; j < 3; ++j) {
+            if (tris_[t].n[j] == nb) return j;
+        }
+        return -1;
+    }
+
+    int allocate() {
+        if (!free_.empty()) {
+            const int id = free_.back();
+            free_.pop_back();
+            return id;
+        }
+        tris_.emplace_back();
+        mark_.push_back(0);
+        return static_cast<int>(tris_.size()) - 1;
+    }
+
+    void release(int t) {
+        tris_[t] = Tri{{-1, -1, -1}, {-1, -1, -1}};
+        free_.push_back(t);
+    }
+
+    bool in_circle(int t, const Vec& P) const {
+        const Tri& T = tris_[t];
+        return in_circumcircle(pts_[T.v[0]], pts_[T.v[1]], pts_[T.v[2]], P);
+    }
+
+    unsigned next_random() {
+        rng_ ^= rng_ << 13; rng_ ^= rng_ >> 17; rng_ ^= rng_ << 5;
+        return rng_;
+    }
+
+    double dist2(int t, const Vec& P) const {
+        const Vec& q = pts_[tris_[t].v[0]];
+        return (q.x - P.x)*(q.x - P.x) + (q.y - P.y)*(q.y - P.y);
+    }
+
+    int jump(const Vec& P) {
+        int best = last_;
+        double bestD = dist2(best, P);
+        const unsigned count = static_cast<unsigned>(tris_.size());
+        int samples = static_cast<int>(std::cbrt(static_cast<double>(count)));
+        while (samples-- > 0) {
+            const int t = static_cast<int>(next_random() % count);
+            if (tris_[t].v[0] < 0) continue;
+            const double d = dist2(t, P);
+            if (d < bestD) { bestD = d; best = t; }
+        }
+        return best;
+    }
+
+    int locate(const Vec& P) {
+        int t = jump_ ? jump(P) : last_;
+        const size_t limit = 4 * tris_.size() + 16;
+        for (size_t step = 0; step < limit; ++step) {
+            const Tri& T = tris_[t];
+            const int r = static_cast<int>(next_random() % 3u);
+            int next = -1;
+            for (int k = 0; k < 3; ++k) {
+                const int i = (k + r) % 3;
+                if (T.n[i] < 0) continue;
+                if (orient(pts_[T.v[(i+1)%3]], pts_[T.v[(i+2)%3]], P) < 0.0) {
+                    next = T.n[i];
+                    break;
+                }
+            }
+            if (next < 0) return t;
+            t = next;
+        }
+
+        for (int s = 0; s < static_cast<int>(tris_.size()); ++s) {
+            const Tri& T = tris_[s];
+            if (T.v[0] < 0) continue;
+            if (orient(pts_[T.v[0]], pts_[T.v[1]], P) >= 0.0 &&
+                orient(pts_[T.v[1]], pts_[T.v[2]], P) >= 0.0 &&
+                orient(pts_[T.v[2]], pts_[T.v[0]], P) >= 0.0) return s;
+        }
+        return t;
+    }
+
+    std::vector<Vec> pts_;
+    bool jump_ = true;
+    std::vector<Tri> tris_;
+    std::vector<unsigned> mark_;
+    std::vector<int> vtri_;
+    std::vector<int> start_;
+    std::vector<int> free_;
+    std::vector<int> cavity_;
+    std::vector<Edge> boundary_;
+    std::vector<int> created_;
+    std::vector<int> ring_;
+    std::vector<Edge> star_;
+    std::vector<int> open_;
+    std::vector<std::array<int, 3>> ears_;
+    unsigned epoch_ = 0;
+    int last_ = 0;
+    unsigned rng_ = 2463534242u;
+};
+
+uint32_t hilbert_index(uint32_t x, uint32_t y) {
+    uint32_t d = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+        const uint32_t rx = (x & s) ? 1u : 0u;
+        const uint32_t ry = (y & s) ? 1u : 0u;
+        d += s * s * ((3u * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
 
+std::vector<int> brio_order(const std::vector<Point>& pts) {
+    const int n = static_cast<int>(pts.size());
     long double minx = std::numeric_limits<long double>::infinity();
     long double miny = std::numeric_limits<long double>::infinity();
     long double maxx = -minx;
@@ -51,89 +441,422 @@ bool delaunay_triangulation(const std::vector<Point>& pts,
         if (p.y < miny) miny = p.y;
         if (p.y > maxy) maxy = p.y;
     }
+    const long double span = std::max(maxx - minx, maxy - miny);
+    const long double scale = span > 0.0L ? 65535.0L / span : 0.0L;
 
-    const long double dx = maxx - minx;
-    const long double dy = maxy - miny;
-    const long double delta = (dx > dy ? dx : dy);
-    const long double cx = (minx + maxx) * 0.5L;
-    const long double cy = (miny + maxy) * 0.5L;
-    const long double R  = 4.0L * (delta + 1.0L);
+    std::vector<std::pair<uint64_t, int>> keys(n);
+    uint32_t rng = 88172645u;
+    for (int i = 0; i < n; ++i) {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        uint64_t round = 0;
+        for (uint32_t bits = rng; (bits & 1u) && round < 31; bits >>= 1) ++round;
+        const uint32_t hx = static_cast<uint32_t>((pts[i].x - minx) * scale);
+        const uint32_t hy = static_cast<uint32_t>((pts[i].y - miny) * scale);
+        keys[i] = {((31 - round) << 32) | hilbert_index(hx, hy), i};
+    }
+    std::sort(keys.begin(), keys.end());
 
-    Point st0{cx - 2.0L*R, cy - R};
-    Point st1{cx,           cy + 2.0L*R};
-    Point st2{cx + 2.0L*R, cy - R};
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) order[i] = keys[i].second;
+    return order;
+}
 
-    const int i0 = n;
-    const int i1 = n + 1;
-    const int i2 = n + 2;
+inline uint64_t edge_key(int u, int v) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(u)) << 32) |
+           static_cast<uint32_t>(v);
+}
 
-    std::vector<Point> ptsTmp = pts;
-    ptsTmp.push_back(st0);
-    ptsTmp.push_back(st1);
-    ptsTmp.push_back(st2);
+struct Strip {
+    std::vector<Triangle> fixed;
+    std::vector<uint64_t> seams;
+    std::vector<int> border;
+};
 
-    std::vector<Triangle> triang;
-    triang.emplace_back(Triangle{i0, i1, i2});
+void triangulate_strip(const std::vector<Point>& pts, const int* ids, int count,
+                       double lo, double hi, double tol, const Frame& frame,
+                       Strip* out)
+{
+    std::vector<Point> local(count);
+    for (int i = 0; i < count; ++i) local[i] = pts[ids[i]];
+    Triangulator tri(local, false, frame);
+    for (int pi : brio_order(local)) tri.insert(pi + kSuper);
 
-    for (int pi = 0; pi < n; ++pi) {
-        const Point& P = ptsTmp[pi];
+    const std::vector<Tri>& mesh = tri.mesh();
+    std::vector<char> fin(mesh.size(), 0);
+    std::vector<int> work;
+    for (size_t t = 0; t < mesh.size(); ++t) {
+        const Tri& T = mesh[t];
+        if (!tri.real(T)) continue;
+        const Circle c = circumcircle(tri.point(T.v[0]), tri.point(T.v[1]), tri.point(T.v[2]));
+        if (c.x - c.r > lo + tol && c.x + c.r < hi - tol) {
+            fin[t] = 1;
+            work.push_back(static_cast<int>(t));
+        }
+    }
 
-        std::vector<int> bad;
-        bad.reserve(triang.size());
-        for (int t = 0; t < static_cast<int>(triang.size()); ++t) {
-            const Triangle& T = triang[t];
-            if (in_circumcircle(ptsTmp[T.a], ptsTmp[T.b], ptsTmp[T.c], P)) {
-                bad.push_back(t);
+    while (!work.empty()) {
+        const int t = work.back();
+        work.pop_back();
+        if (!fin[t]) continue;
+        const Tri& T = mesh[t];
+        for (int i = 0; i < 3; ++i) {
+            const int nb = T.n[i];
+            if (nb < 0 || fin[nb] || !tri.real(mesh[nb])) continue;
+            int far = -1;
+            for (int j = 0; j < 3; ++j) {
+                if (mesh[nb].n[j] == t) { far = mesh[nb].v[j]; break; }
             }
+            if (outside_circumcircle(tri.point(T.v[0]), tri.point(T.v[1]),
+                                     tri.point(T.v[2]), tri.point(far))) continue;
+            fin[t] = 0;
+            for (int k = 0; k < 3; ++k) {
+                if (T.n[k] >= 0 && fin[T.n[k]]) work.push_back(T.n[k]);
+            }
+            break;
         }
+    }
 
-        struct Edge { int u, v; };
-        std::vector<Edge> boundary;
-        auto add_edge = [&](int u, int v){
-            for (size_t k=0;k<boundary.size();++k) {
-                if (boundary[k].u == v && boundary[k].v == u) {
-                    boundary.erase(boundary.begin()+k);
-                    return;
-                }
+    auto gid = [&](int v) { return ids[v - kSuper]; };
+    std::vector<char> seam(count + kSuper, 1);
+    for (size_t t = 0; t < mesh.size(); ++t) {
+        if (fin[t]) {
+            for (int v : mesh[t].v) seam[v] = 0;
+        }
+    }
+    for (size_t t = 0; t < mesh.size(); ++t) {
+        const Tri& T = mesh[t];
+        if (!fin[t]) {
+            for (int v : T.v) seam[v] = 2;
+            continue;
+        }
+        out->fixed.push_back(Triangle{gid(T.v[0]), gid(T.v[1]), gid(T.v[2])});
+        for (int i = 0; i < 3; ++i) {
+            if (T.n[i] >= 0 && fin[T.n[i]]) continue;
+            out->seams.push_back(edge_key(gid(T.v[(i+1)%3]), gid(T.v[(i+2)%3])));
+        }
+    }
+    for (int v = kSuper; v < count + kSuper; ++v) {
+        if (seam[v]) out->border.push_back(gid(v));
+    }
+}
+
+bool parallel_triangulation(const std::vector<Point>& pts, int threads,
+                            std::vector<Triangle>* out)
+{
+    const int n = static_cast<int>(pts.size());
+    const int parts = std::min(threads, n / 8192);
+    if (parts < 2) return false;
+
+    std::vector<int> idx(n);
+    std::iota(idx.begin(), idx.end(), 0);
+    auto less = [&](int i, int j) {
+        if (pts[i].x < pts[j].x) return true;
+        if (pts[i].x > pts[j].x) return false;
+        if (pts[i].y < pts[j].y) return true;
+        if (pts[i].y > pts[j].y) return false;
+        return i < j;
+    };
+
+    std::vector<int> bounds(parts + 1);
+    for (int s = 0; s <= parts; ++s) {
+        bounds[s] = static_cast<int>(static_cast<long long>(s) * n / parts);
+    }
+    std::vector<std::pair<int,int>> level{{0, parts}};
+    while (!level.empty()) {
+        std::vector<std::pair<int,int>> next;
+        for (const auto& r : level) {
+            if (r.second - r.first < 2) continue;
+            const int mid = (r.first + r.second) / 2;
+            next.push_back({r.first, mid});
+            next.push_back({mid, r.second});
+        }
+        common::parallel_for(level.size(), threads, [&](size_t i, int) {
+            const auto& r = level[i];
+            if (r.second - r.first < 2) return;
+            const int mid = (r.first + r.second) / 2;
+            std::nth_element(idx.begin() + bounds[r.first], idx.begin() + bounds[mid],
+                             idx.begin() + bounds[r.second], less);
+        });
+        level.swap(next);
+    }
+
+    // Sorted strips hold exact repeats next to each other across the whole
+    // x order; the serial engine keeps the first copy it inserts, so keep
+    // the one with the lowest index and drop the rest.
+    common::parallel_for(parts, threads, [&](size_t s, int) {
+        std::sort(idx.begin() + bounds[s], idx.begin() + bounds[s+1], less);
+    });
+    int kept = 0;
+    for (int s = 0; s < parts; ++s) {
+        const int from = bounds[s];
+        bounds[s] = kept;
+        for (int k = from; k < bounds[s+1]; ++k) {
+            const Point& p = pts[idx[k]];
+            if (kept > 0 && pts[idx[kept-1]].x == p.x && pts[idx[kept-1]].y == p.y) continue;
+            idx[kept++] = idx[k];
+        }
+    }
+    bounds[parts] = kept;
+    for (int s = 0; s < parts; ++s) {
+        if (bounds[s] == bounds[s+1]) return false;
+    }
+
+    double minx = std::numeric_limits<double>::infinity();
+    double miny = minx;
+    double maxx = -minx;
+    double maxy = -miny;
+    for (const auto& p : pts) {
+        minx = std::min(minx, p.x); maxx = std::max(maxx, p.x);
+        miny = std::min(miny, p.y); maxy = std::max(maxy, p.y);
+    }
+    const double tol = 1e-9 * std::max(maxx - minx, maxy - miny);
+    const Frame frame = super_triangle(pts, 1.0);
+
+    std::vector<Strip> strips(parts);
+    common::parallel_for(parts, threads, [&](size_t s, int) {
+        const double inf = std::numeric_limits<double>::infinity();
+        const double lo = s > 0 ? pts[idx[bounds[s] - 1]].x : -inf;
+        const double hi = s + 1 < static_cast<size_t>(parts) ? pts[idx[bounds[s+1]]].x : inf;
+        triangulate_strip(pts, idx.data() + bounds[s], bounds[s+1] - bounds[s],
+                          lo, hi, tol, frame, &strips[s]);
+    });
+
+    std::vector<int> border;
+    std::unordered_set<uint64_t> seams;
+    size_t fixedCount = 0;
+    for (const Strip& st : strips) {
+        border.insert(border.end(), st.border.begin(), st.border.end());
+        seams.insert(st.seams.begin(), st.seams.end());
+        fixedCount += st.fixed.size();
+    }
+
+    std::vector<Point> sub(border.size());
+    for (size_t i = 0; i < border.size(); ++i) sub[i] = pts[border[i]];
+    Triangulator tri(sub, false, frame);
+    for (int pi : brio_order(sub)) tri.insert(pi + kSuper);
+    auto gid = [&](int v) { return border[v - kSuper]; };
+
+    const std::vector<Tri>& mesh = tri.mesh();
+    std::vector<char> inside(mesh.size(), 0);
+    std::vector<int> work;
+    size_t matched = 0;
+    for (size_t t = 0; t < mesh.size(); ++t) {
+        const Tri& T = mesh[t];
+        if (!tri.real(T)) continue;
+        for (int i = 0; i < 3; ++i) {
+            if (!seams.count(edge_key(gid(T.v[(i+1)%3]), gid(T.v[(i+2)%3])))) continue;
+            ++matched;
+            if (!inside[t]) {
+                inside[t] = 1;
+                work.push_back(static_cast<int>(t));
             }
-            boundary.push_back({u,v});
-        };
+        }
+    }
+    if (matched != seams.size()) return false;
 
-        std::vector<char> kill(triang.size(), 0);
-        for (int id : bad) {
-            const Triangle& T = triang[id];
-            add_edge(T.a, T.b);
-            add_edge(T.b, T.c);
-            add_edge(T.c, T.a);
-            kill[id] = 1;
+    while (!work.empty()) {
+        const int t = work.back();
+        work.pop_back();
+        const Tri& T = mesh[t];
+        for (int i = 0; i < 3; ++i) {
+            const int nb = T.n[i];
+            if (nb < 0 || inside[nb] || !tri.real(mesh[nb])) continue;
+            if (seams.count(edge_key(gid(T.v[(i+1)%3]), gid(T.v[(i+2)%3])))) continue;
+            inside[nb] = 1;
+            work.push_back(nb);
         }
+    }
+
+    out->clear();
+    out->reserve(fixedCount + mesh.size());
+    for (const Strip& st : strips) {
+        out->insert(out->end(), st.fixed.begin(), st.fixed.end());
+    }
+    for (size_t t = 0; t < mesh.size(); ++t) {
+        const Tri& T = mesh[t];
+        if (inside[t] || !tri.real(T)) continue;
+        out->push_back(Triangle{gid(T.v[0]), gid(T.v[1]), gid(T.v[2])});
+    }
+    return true;
+}
 
-        std::vector<Triangle> kept;
-        kept.reserve(triang.size());
-        for (int t = 0; t < static_cast<int>(triang.size()); ++t) {
-            if (!kill[t]) kept.push_back(triang[t]);
+void link_triangles(int n, const std::vector<Triangle>& tris,
+                    std::vector<TriangleAdjacency>* adj)
+{
+    std::vector<int> head(n + 1, 0);
+    for (const Triangle& T : tris) {
+        ++head[T.a + 1]; ++head[T.b + 1]; ++head[T.c + 1];
+    }
+    std::partial_sum(head.begin(), head.end(), head.begin());
+    std::vector<std::pair<int,int>> outgoing(head[n]);
+    std::vector<int> fill(head.begin(), head.end() - 1);
+    for (int t = 0; t < static_cast<int>(tris.size()); ++t) {
+        const Triangle& T = tris[t];
+        outgoing[fill[T.a]++] = {T.b, t};
+        outgoing[fill[T.b]++] = {T.c, t};
+        outgoing[fill[T.c]++] = {T.a, t};
+    }
+    auto across = [&](int u, int v) {
+        for (int k = head[v]; k < head[v + 1]; ++k) {
+            if (outgoing[k].first == u) return outgoing[k].second;
         }
-        triang.swap(kept);
+        return -1;
+    };
 
-        for (const auto& e : boundary) {
-            long double o = orient(ptsTmp[e.u], ptsTmp[e.v], P);
-            if (o > 0.0L) {
-                triang.emplace_back(Triangle{e.u, e.v, pi});
+    adj->clear();
+    adj->reserve(tris.size());
+    for (const Triangle& T : tris) {
+        adj->push_back(TriangleAdjacency{across(T.a, T.b), across(T.b, T.c), across(T.c, T.a)});
+    }
+}
+}
+
+bool delaunay_triangulation(const std::vector<Point>& pts,
+                            std::vector<Triangle>* triangles)
+{
+    return delaunay_triangulation(pts, triangles, nullptr, DelaunayOptions{});
+}
+
+bool delaunay_triangulation(const std::vector<Point>& pts,
+                            std::vector<Triangle>* triangles,
+                            std::vector<TriangleAdjacency>* adjacency)
+{
+    return delaunay_triangulation(pts, triangles, adjacency, DelaunayOptions{});
+}
+
+bool delaunay_triangulation(const std::vector<Point>& pts,
+                            std::vector<Triangle>* triangles,
+                            std::vector<TriangleAdjacency>* adjacency,
+                            const DelaunayOptions& options)
+{
+    triangles->clear();
+    if (adjacency) adjacency->clear();
+    const int n = static_cast<int>(pts.size());
+    if (n < 2) return false;
+    if (n == 2) return true;
+
+    const int threads = common::resolve_threads(options.threads);
+    if (threads > 1 && parallel_triangulation(pts, threads, triangles)) {
+        if (adjacency) link_triangles(n, *triangles, adjacency);
+        return true;
+    }
+
+    if (options.order == InsertionOrder::Brio) {
+        Triangulator tri(pts, false);
+        for (int pi : brio_order(pts)) tri.insert(pi + kSuper);
+        tri.collect(triangles, adjacency);
+    } else {
+        Triangulator tri(pts, true);
+        for (int pi = 0; pi < n; ++pi) tri.insert(pi + kSuper);
+        tri.collect(triangles, adjacency);
+    }
+    return true;
+}
+
+struct DelaunayMesh::Impl {
+    static constexpr double kGrow = 16.0;
+
+    std::vector<Point> pts;
+    Triangulator tri{std::vector<Point>{}, false, kGrow};
+    std::vector<int> isolated;
+
+    void rebuild(double margin) {
+        tri = Triangulator(pts, false, margin);
+        isolated.clear();
+        for (int pi : brio_order(pts)) {
+            if (!tri.insert(pi + kSuper)) isolated.push_back(pi);
+        }
+    }
+
+    void attach(int i) {
+        if (!tri.covers(pts[i])) {
+            rebuild(kGrow);
+            return;
+        }
+        if (!tri.insert(i + kSuper)) isolated.push_back(i);
+    }
+
+    void detach(int i) {
+        if (!tri.attached(i + kSuper)) {
+            isolated.erase(std::find(isolated.begin(), isolated.end(), i));
+            return;
+        }
+        tri.remove(i + kSuper);
+        for (size_t k = 0; k < isolated.size();) {
+            if (tri.insert(isolated[k] + kSuper)) {
+                isolated[k] = isolated.back();
+                isolated.pop_back();
             } else {
-                triang.emplace_back(Triangle{e.v, e.u, pi});
+                ++k;
             }
         }
     }
+};
+
+DelaunayMesh::DelaunayMesh() : impl_(std::make_unique<Impl>()) {}
+
+DelaunayMesh::DelaunayMesh(const std::vector<Point>& pts)
+    : impl_(std::make_unique<Impl>())
+{
+    impl_->pts = pts;
+    impl_->rebuild(1.0);
+}
+
+DelaunayMesh::~DelaunayMesh() = default;
+DelaunayMesh::DelaunayMesh(DelaunayMesh&& other) noexcept = default;
+DelaunayMesh& DelaunayMesh::operator=(DelaunayMesh&& other) noexcept = default;
+
+int DelaunayMesh::insert(const Point& p) {
+    Impl& m = *impl_;
+    m.pts.push_back(p);
+    m.tri.add_point(p);
+    const int idx = static_cast<int>(m.pts.size()) - 1;
+    m.attach(idx);
+    return idx;
+}
 
-    std::vector<Triangle> result;
-    result.reserve(triang.size());
-    for (const auto& T : triang) {
-        if (T.a >= i0 || T.b >= i0 || T.c >= i0) continue;
-        result.push_back(T);
+bool DelaunayMesh::remove(int index) {
+    Impl& m = *impl_;
+    if (index < 0 || index >= static_cast<int>(m.pts.size())) return false;
+    m.detach(index);
+
+    const int last = static_cast<int>(m.pts.size()) - 1;
+    if (index != last) {
+        m.tri.rename(last + kSuper, index + kSuper);
+        m.pts[index] = m.pts[last];
+        std::replace(m.isolated.begin(), m.isolated.end(), last, index);
     }
+    m.pts.pop_back();
+    m.tri.drop_last_point();
+    return true;
+}
 
-    triangles->swap(result);
+bool DelaunayMesh::move(int index, const Point& p) {
+    Impl& m = *impl_;
+    if (index < 0 || index >= static_cast<int>(m.pts.size())) return false;
+    m.detach(index);
+    m.pts[index] = p;
+    m.tri.set_point(index + kSuper, p);
+    m.attach(index);
     return true;
 }
 
+void DelaunayMesh::clear() {
+    impl_ = std::make_unique<Impl>();
+}
+
+const std::vector<Point>& DelaunayMesh::points() const {
+    return impl_->pts;
+}
+
+size_t DelaunayMesh::size() const {
+    return impl_->pts.size();
+}
+
+void DelaunayMesh::triangles(std::vector<Triangle>* out,
+                             std::vector<TriangleAdjacency>* adjacency) const
+{
+    impl_->tri.collect(out, adjacency);
+}
+
 } 
@@ -1,21 +1,63 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 
 namespace task789 {
 
 struct Point {
-    long double x = 0.0L;
-    long double y = 0.0L;
+    double x = 0.0;
+    double y = 0.0;
 };
 
 using Polygon = std::vector<Point>;
 
 Polygon convex_hull(const std::vector<Point>& pts);
 
+// Minkowski sum A + B and difference A - B = A + (-B) of two convex
+// counter-clockwise polygons in O(n + m), by merging their edges in angle
+// order. The result is counter-clockwise without collinear vertices; `out`
+// is cleared and refilled. Returns false when either input is empty.
+bool minkowski_sum(const Polygon& A, const Polygon& B, Polygon* out);
+bool minkowski_difference(const Polygon& A, const Polygon& B, Polygon* out);
+
+// Batch forms against one shared B, e.g. many obstacles and one footprint:
+// (*out)[i] is As[i] + B or As[i] - B. Inputs are processed in blocks on
+// `threads` workers (0 = all cores), reusing the buffers already in `out`.
+void minkowski_sums(const std::vector<Polygon>& As, const Polygon& B,
+                    std::vector<Polygon>* out, int threads = 0);
+void minkowski_differences(const std::vector<Polygon>& As, const Polygon& B,
+                           std::vector<Polygon>* out, int threads = 0);
+
+// Intersection of two convex counter-clockwise polygons in O(n + m). `out`
+// is cleared and refilled, so a reused buffer stops allocating once it is
+// large enough. Returns false when the interiors do not overlap.
+bool intersect_convex(const Polygon& A, const Polygon& B, Polygon* out);
+
 enum class Operation { Intersection, Union, DifferenceAB };
 
 std::vector<Polygon> boolean_operation(const Polygon& hullA,
                                        const Polygon& hullB,
                                        Operation op);
 
+struct BooleanJob {
+    const Polygon* a = nullptr;
+    const Polygon* b = nullptr;
+    Operation op = Operation::Intersection;
+};
+
+// Results of boolean_operations, flattened: job j produced the polygons
+// [jobs[j], jobs[j+1]), and polygon k is vertices[polygons[k], polygons[k+1]).
+struct BooleanBatch {
+    std::vector<Point> vertices;
+    std::vector<size_t> polygons;
+    std::vector<size_t> jobs;
+};
+
+// boolean_operation over many pairs, in blocks on `threads` workers (0 = all
+// cores). Each worker keeps one set of buffers for all of its jobs, so the
+// per-job cost is free of allocations once they have grown; `out` is cleared
+// and refilled in job order. Jobs with a null polygon produce nothing.
+void boolean_operations(const std::vector<BooleanJob>& jobs, BooleanBatch* out,
+                        int threads = 0);
+
 } 
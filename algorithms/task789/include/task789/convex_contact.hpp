@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+
+#include "task789/convex_boolean.hpp"
+
+namespace task789 {
+
+// Overlap queries on convex counter-clockwise polygons (as returned by
+// convex_hull) that never build the intersection. Both walk the edges of the
+// Minkowski difference A - B once, i.e. the separating-axis test against every
+// edge normal with its support vertex found incrementally: O(n + m).
+// Polygons with fewer than three vertices never overlap anything.
+
+struct ConvexContact {
+    // Touching counts as overlapping.
+    bool overlap = false;
+    // Moving B by depth * normal makes the polygons just touch: depth is the
+    // penetration depth when they overlap and minus their distance when they
+    // do not. `normal` is a unit vector pointing from A towards B.
+    long double depth = 0.0L;
+    Point normal;
+};
+
+// Stops at the first separating axis.
+bool convex_overlap(const Polygon& A, const Polygon& B);
+
+bool convex_contact(const Polygon& A, const Polygon& B, ConvexContact* out);
+
+struct PolygonPair {
+    const Polygon* a = nullptr;
+    const Polygon* b = nullptr;
+};
+
+// Batch forms: (*out)[i] answers pairs[i]; pairs with a null polygon do not
+// overlap. Pairs are processed in blocks on `threads` workers (0 = all cores).
+void convex_overlaps(const std::vector<PolygonPair>& pairs, std::vector<char>* out,
+                     int threads = 0);
+void convex_contacts(const std::vector<PolygonPair>& pairs, std::vector<ConvexContact>* out,
+                     int threads = 0);
+
+} 
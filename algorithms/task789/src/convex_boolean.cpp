@@ -2,7 +2,11 @@
 
 #include <algorithm>
 #include <cmath>
-#include <set>
+#include <cstdint>
+
+#include "common/hull_filter.hpp"
+#include "common/parallel.hpp"
+#include "common/predicates.hpp"
 
 namespace task789 {
 namespace {
@@ -21,33 +25,41 @@ inline bool ccw(const Polygon& p) {
     return s > 0.0L;
 }
 
+// Drops near-duplicate vertices, then exactly collinear ones judged against
+// their original neighbours, all in place. Every slot is read before it is
+// overwritten except the first, and only the first two are written when
+// too few vertices survive, so those are kept aside.
 inline void cleanup_polygon(Polygon& poly) {
     const long double eps2 = 1e-24L;
+    auto close = [&](const Point& a, const Point& b) {
+        const long double dx = a.x - b.x, dy = a.y - b.y;
+        return dx*dx + dy*dy <= eps2;
+    };
     if (poly.size() < 2) return;
 
-    Polygon t; t.reserve(poly.size());
-    t.push_back(poly[0]);
+    size_t m = 1;
     for (size_t i=1;i<poly.size();++i) {
-        long double dx = poly[i].x - t.back().x;
-        long double dy = poly[i].y - t.back().y;
-        if (dx*dx + dy*dy > eps2) t.push_back(poly[i]);
-    }
-    if (t.size() >= 2) {
-        long double dx = t.front().x - t.back().x;
-        long double dy = t.front().y - t.back().y;
-        if (dx*dx + dy*dy <= eps2) t.pop_back();
-    }
-    if (t.size() < 3) { poly.swap(t); return; }
-
-    Polygon r; r.reserve(t.size());
-    for (size_t i=0;i<t.size();++i) {
-        const Point& A = t[(i + t.size() - 1) % t.size()];
-        const Point& B = t[i];
-        const Point& C = t[(i + 1) % t.size()];
-        long double cr = cross(A, B, C);
-        if (std::fabsl(cr) > 1e-18L) r.push_back(B);
-    }
-    if (r.size() >= 3) poly.swap(r); else poly.swap(t);
+        if (!close(poly[i], poly[m-1])) poly[m++] = poly[i];
+    }
+    if (m >= 2 && close(poly[0], poly[m-1])) --m;
+    poly.resize(m);
+    if (m < 3) return;
+
+    const Point first = poly[0], second = poly[1];
+    Point prev = poly[m-1];
+    size_t k = 0;
+    for (size_t i=0;i<m;++i) {
+        const Point cur = poly[i];
+        const Point& next = i + 1 < m ? poly[i+1] : first;
+        if (common::orient2d(prev, cur, next) != 0.0) poly[k++] = cur;
+        prev = cur;
+    }
+    if (k >= 3) {
+        poly.resize(k);
+    } else {
+        poly[0] = first;
+        poly[1] = second;
+    }
 }
 
 inline Point seg_intersect(const Point& S, const Point& E,
@@ -57,11 +69,11 @@ inline Point seg_intersect(const Point& S, const Point& E,
     const long double X1=S.x, Y1=S.y, X2=E.x, Y2=E.y;
     const long double X3=A.x, Y3=A.y, X4=B.x, Y4=B.y;
     const long double den = (X1-X2)*(Y3-Y4) - (Y1-Y2)*(X3-X4);
-    if (std::fabsl(den) < eps) return S;
+    if (std::fabs(den) < eps) return S;
 
     const long double nx = ((X1*Y2 - Y1*X2)*(X3-X4) - (X1-X2)*(X3*Y4 - Y3*X4));
     const long double ny = ((X1*Y2 - Y1*X2)*(Y3-Y4) - (Y1-Y2)*(X3*Y4 - Y3*X4));
-    return Point{ nx/den, ny/den };
+    return Point{ static_cast<double>(nx/den), static_cast<double>(ny/den) };
 }
 
 inline Polygon suth_hodg_clip(const Polygon& subject, const Polygon& clipPoly,
@@ -102,20 +114,241 @@ inline Polygon suth_hodg_clip(const Polygon& subject, const Polygon& clipPoly,
     return output;
 }
 
-inline Polygon intersection_convex(const Polygon& A, const Polygon& B) {
-    return suth_hodg_clip(A, B, +1);
+inline int sign(double v) { return (v > 0.0) - (v < 0.0); }
+
+enum class Crossing { None, Proper, Vertex, Overlap };
+
+// Segments a1a2 and b1b2 by exact orientation signs; `p` is the crossing
+// point, or one end of the overlap for collinear segments.
+Crossing cross_segments(const Point& a1, const Point& a2,
+                        const Point& b1, const Point& b2, Point& p)
+{
+    const int o1 = sign(common::orient2d(a1, a2, b1));
+    const int o2 = sign(common::orient2d(a1, a2, b2));
+    const int o3 = sign(common::orient2d(b1, b2, a1));
+    const int o4 = sign(common::orient2d(b1, b2, a2));
+
+    if (o1 == 0 && o2 == 0) {
+        auto between = [](const Point& s, const Point& e, const Point& q) {
+            return std::min(s.x, e.x) <= q.x && q.x <= std::max(s.x, e.x) &&
+                   std::min(s.y, e.y) <= q.y && q.y <= std::max(s.y, e.y);
+        };
+        if (between(a1, a2, b1)) { p = b1; return Crossing::Overlap; }
+        if (between(a1, a2, b2)) { p = b2; return Crossing::Overlap; }
+        if (between(b1, b2, a1)) { p = a1; return Crossing::Overlap; }
+        return Crossing::None;
+    }
+    if (o1 * o2 > 0 || o3 * o4 > 0) return Crossing::None;
+
+    if (o3 == 0) { p = a1; return Crossing::Vertex; }
+    if (o4 == 0) { p = a2; return Crossing::Vertex; }
+    if (o1 == 0) { p = b1; return Crossing::Vertex; }
+    if (o2 == 0) { p = b2; return Crossing::Vertex; }
+    p = seg_intersect(a1, a2, b1, b2);
+    return Crossing::Proper;
 }
 
-int ensure_point_id(const Point& p, std::vector<Point>& pool) {
-    const long double eps = 1e-12L;
-    for (size_t i=0;i<pool.size();++i) {
-        if (std::fabsl(pool[i].x - p.x) <= eps &&
-            std::fabsl(pool[i].y - p.y) <= eps) return static_cast<int>(i);
+bool inside_convex(const Polygon& poly, const Point& p) {
+    for (size_t i = 0; i < poly.size(); ++i) {
+        if (common::orient2d(poly[i], poly[(i+1) % poly.size()], p) < 0.0) return false;
     }
-    pool.push_back(p);
-    return static_cast<int>(pool.size()) - 1;
+    return true;
 }
 
+struct ChainCrossing {
+    Point p;
+    // Heads of the crossing edges: the edges run A[a-1] -> A[a], B[b-1] -> B[b].
+    size_t a = 0;
+    size_t b = 0;
+    // A's boundary runs inside B right after p (else B's runs inside A).
+    bool a_inside = false;
+};
+
+enum class Chase { Crossed, NoCrossing, Separated, Degenerate };
+
+// O'Rourke, Chien, Olson and Naddor: advance on A or B depending on which
+// edge aims at the other, emitting the chain that is currently inside and
+// every boundary crossing. At most 2(n + m) steps. `out` gets the untidied
+// intersection outline and `crossings`, unless null, every boundary
+// crossing once, in counter-clockwise order. A vertex only on the line of
+// the other's edge is not a contact: zero sides count as not inside, and
+// collinear edges that do not overlap are stepped past, as in O'Rourke's
+// advance rules. A walk that meets a vertex on the other boundary or
+// overlapping edges stops with Degenerate.
+Chase chase_convex(const Polygon& A, const Polygon& B, Polygon* out,
+                   std::vector<ChainCrossing>* crossings)
+{
+    out->clear();
+    if (crossings) crossings->clear();
+    const size_t n = A.size(), m = B.size();
+    if (n < 3 || m < 3) return Chase::Separated;
+
+    enum class Inside { Unknown, A, B };
+    Inside in = Inside::Unknown;
+    size_t a = 0, b = 0, aa = 0, ba = 0;
+    // Edge heads at the first crossing; the walk ends when it comes back.
+    bool crossed = false;
+    size_t first_a = 0, first_b = 0;
+
+    auto advance = [&](size_t& idx, size_t& steps, size_t size, bool emit, const Point& v) {
+        if (emit) out->push_back(v);
+        idx = (idx + 1) % size;
+        ++steps;
+    };
+
+    do {
+        const size_t a1 = (a + n - 1) % n;
+        const size_t b1 = (b + m - 1) % m;
+        const Point ea{A[a].x - A[a1].x, A[a].y - A[a1].y};
+        const Point eb{B[b].x - B[b1].x, B[b].y - B[b1].y};
+        const int turn = sign(common::orient2d(Point{}, ea, eb));
+        const int a_of_b = sign(common::orient2d(B[b1], B[b], A[a]));
+        const int b_of_a = sign(common::orient2d(A[a1], A[a], B[b]));
+
+        Point p;
+        const Crossing c = cross_segments(A[a1], A[a], B[b1], B[b], p);
+        if (c == Crossing::Vertex || c == Crossing::Overlap) return Chase::Degenerate;
+        if (c == Crossing::Proper) {
+            if (crossed && first_a == a && first_b == b) break;
+            if (!crossed) {
+                aa = ba = 0;
+                crossed = true;
+                first_a = a;
+                first_b = b;
+            }
+            out->push_back(p);
+            in = a_of_b > 0 ? Inside::A : Inside::B;
+            if (crossings) crossings->push_back(ChainCrossing{p, a, b, in == Inside::A});
+        }
+
+        if (turn == 0 && a_of_b < 0 && b_of_a < 0) return Chase::Separated;
+        if (turn == 0 && a_of_b == 0 && b_of_a == 0) {
+            if (in == Inside::A) advance(b, ba, m, false, B[b]);
+            else advance(a, aa, n, false, A[a]);
+        } else if (turn >= 0) {
+            if (b_of_a > 0) advance(a, aa, n, in == Inside::A, A[a]);
+            else advance(b, ba, m, in == Inside::B, B[b]);
+        } else {
+            if (a_of_b > 0) advance(b, ba, m, in == Inside::B, B[b]);
+            else advance(a, aa, n, in == Inside::A, A[a]);
+        }
+    } while ((aa < n || ba < m) && aa < 2*n && ba < 2*m);
+
+    return crossed ? Chase::Crossed : Chase::NoCrossing;
+}
+
+// Falls back to the Sutherland-Hodgman clipper for degenerate contacts, so
+// they keep their previous results.
+bool clip_convex(const Polygon& A, const Polygon& B, Polygon* out) {
+    switch (chase_convex(A, B, out, nullptr)) {
+    case Chase::Degenerate:
+        *out = suth_hodg_clip(A, B, +1);
+        break;
+    case Chase::NoCrossing:
+        out->clear();
+        if (inside_convex(B, A[0])) out->assign(A.begin(), A.end());
+        else if (inside_convex(A, B[0])) out->assign(B.begin(), B.end());
+        break;
+    case Chase::Separated:
+        out->clear();
+        break;
+    case Chase::Crossed:
+        break;
+    }
+    cleanup_polygon(*out);
+    if (out->size() < 3) out->clear();
+    return !out->empty();
+}
+
+// Welds a point to the earliest pooled one within 1e-12 per coordinate.
+// Cells are at least that wide, so a match can only sit in the 3x3 block
+// around the query cell; chains keep every pooled point, and the lowest id
+// wins as it did with a linear scan. `extent` bounds |x| and |y| and widens
+// the cells enough to keep cell numbers small. Cell heads live in an open
+// addressing table that reset() clears without giving its memory back.
+class PointWelder {
+public:
+    void reset(std::vector<Point>* pool, long double extent, size_t expected) {
+        pool_ = pool;
+        cell_ = std::max(kEps, std::ldexp(extent, -40));
+        size_t capacity = 16;
+        while (capacity < 2 * expected) capacity *= 2;
+        slots_.assign(capacity, Slot{});
+        filled_ = 0;
+        next_.clear();
+    }
+
+    int ensure_point_id(const Point& p) {
+        std::vector<Point>& pool = *pool_;
+        const int64_t cx = cell(p.x), cy = cell(p.y);
+        int best = -1;
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                for (int k = find(key(cx + dx, cy + dy)).head; k >= 0; k = next_[k]) {
+                    if (std::fabs(pool[k].x - p.x) <= kEps &&
+                        std::fabs(pool[k].y - p.y) <= kEps && (best < 0 || k < best)) {
+                        best = k;
+                    }
+                }
+            }
+        }
+        if (best >= 0) return best;
+
+        const int id = static_cast<int>(pool.size());
+        pool.push_back(p);
+        const uint64_t k = key(cx, cy);
+        Slot* slot = &find(k);
+        if (slot->head < 0) {
+            if (2 * (filled_ + 1) > slots_.size()) {
+                grow();
+                slot = &find(k);
+            }
+            slot->key = k;
+            ++filled_;
+        }
+        next_.push_back(slot->head);
+        slot->head = id;
+        return id;
+    }
+
+private:
+    static constexpr long double kEps = 1e-12L;
+
+    struct Slot {
+        uint64_t key = 0;
+        int head = -1;
+    };
+
+    int64_t cell(long double v) const {
+        return static_cast<int64_t>(std::floor(v / cell_));
+    }
+    // Distinct cells that share a key only add candidates to a chain.
+    static uint64_t key(int64_t x, int64_t y) {
+        return static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(y);
+    }
+
+    Slot& find(uint64_t k) {
+        const size_t mask = slots_.size() - 1;
+        size_t i = static_cast<size_t>((k * 0xD6E8FEB86659FD93ull) >> 32) & mask;
+        while (slots_[i].head >= 0 && slots_[i].key != k) i = (i + 1) & mask;
+        return slots_[i];
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        for (const Slot& s : old) {
+            if (s.head >= 0) find(s.key) = s;
+        }
+    }
+
+    std::vector<Point>* pool_ = nullptr;
+    long double cell_ = kEps;
+    std::vector<Slot> slots_;
+    size_t filled_ = 0;
+    std::vector<int> next_;
+};
+
 enum class PointClass { Outside, OnBoundary, Inside };
 
 PointClass classify_point(const Polygon& poly, const Point& p) {
@@ -127,11 +360,73 @@ PointClass classify_point(const Polygon& poly, const Point& p) {
         const Point& b = poly[(i+1)%poly.size()];
         long double v = cross(a,b,p);
         if (v < -eps) return PointClass::Outside;
-        if (std::fabsl(v) <= eps) on = true;
+        if (std::fabs(v) <= eps) on = true;
     }
     return on ? PointClass::OnBoundary : PointClass::Inside;
 }
 
+// classify_point in O(log n) on a convex counter-clockwise polygon: the fan
+// of rays from poly[0] splits it into triangles, a binary search finds the
+// one whose angle holds p, and only that triangle's polygon edge is tested.
+// An edge more than eps outside is a witness, as in the full scan; a point
+// in the closed triangle is in the polygon. Only points just outside, where
+// the scan's tolerance could still accept them, fall back to the scan, so
+// the Outside / not-Outside split always matches it. OnBoundary is judged on
+// the located edge, its neighbours and the two edges at poly[0], which a
+// point in any wedge can be near; it differs from the scan only when a
+// vertex lies within eps of a non-adjacent edge's line. Below a dozen
+// vertices the exact predicates cost more than the scan, which is kept.
+class ConvexLocator {
+public:
+    explicit ConvexLocator(const Polygon& poly) : poly_(poly) {}
+
+    PointClass classify(const Point& p) const {
+        const size_t n = poly_.size();
+        if (n < kScanBelow) return classify_point(poly_, p);
+        const long double eps = 1e-12L;
+        const Point& o = poly_[0];
+
+        const int k = wedge(p);
+        if (k < 0) {
+            if (cross(o, poly_[1], p) < -eps || cross(poly_[n-1], o, p) < -eps) {
+                return PointClass::Outside;
+            }
+            return classify_point(poly_, p);
+        }
+        const Point& a = poly_[k];
+        const Point& b = poly_[k+1];
+        if (cross(a, b, p) < -eps) return PointClass::Outside;
+        if (common::orient2d(a, b, p) < 0.0) return classify_point(poly_, p);
+
+        for (size_t i : {size_t(k) - 1, size_t(k), size_t(k) + 1, size_t(0), n - 1}) {
+            if (std::fabs(cross(poly_[i], poly_[(i+1) % n], p)) <= eps) return PointClass::OnBoundary;
+        }
+        return PointClass::Inside;
+    }
+
+private:
+    static constexpr size_t kScanBelow = 12;
+
+    // Largest k in [1, n-2] with p left of or on the ray poly[0] -> poly[k],
+    // or -1 when p lies outside the angle of the fan.
+    int wedge(const Point& p) const {
+        const size_t n = poly_.size();
+        const Point& o = poly_[0];
+        if (common::orient2d(o, poly_[1], p) < 0.0 || common::orient2d(o, poly_[n-1], p) > 0.0) {
+            return -1;
+        }
+        size_t lo = 1, hi = n - 2;
+        while (lo < hi) {
+            const size_t mid = (lo + hi + 1) / 2;
+            if (common::orient2d(o, poly_[mid], p) >= 0.0) lo = mid;
+            else hi = mid - 1;
+        }
+        return static_cast<int>(lo);
+    }
+
+    const Polygon& poly_;
+};
+
 bool segment_intersection(const Point& a1, const Point& a2,
                           const Point& b1, const Point& b2,
                           Point& out, long double& ta, long double& tb)
@@ -142,7 +437,7 @@ bool segment_intersection(const Point& a1, const Point& a2,
     const long double dx2 = b2.x - b1.x;
     const long double dy2 = b2.y - b1.y;
     const long double denom = dx1*dy2 - dy1*dx2;
-    if (std::fabsl(denom) < eps) return false;
+    if (std::fabs(denom) < eps) return false;
 
     const long double dx = b1.x - a1.x;
     const long double dy = b1.y - a1.y;
@@ -152,80 +447,109 @@ bool segment_intersection(const Point& a1, const Point& a2,
 
     ta = std::clamp(ta, 0.0L, 1.0L);
     tb = std::clamp(tb, 0.0L, 1.0L);
-    out = Point{a1.x + ta*dx1, a1.y + ta*dy1};
+    out = Point{static_cast<double>(a1.x + ta*dx1), static_cast<double>(a1.y + ta*dy1)};
     return true;
 }
 
 struct Edge { int start = 0; int end = 0; };
 
-Polygon polygon_from_edge_loop(const std::vector<Edge>& edges,
-                               const std::vector<Point>& pts,
-                               int startIdx,
-                               std::vector<bool>& used,
-                               const std::vector<std::vector<int>>& outgoing)
-{
-    Polygon poly;
+struct IntersectionInfo {
+    Point p;
+    size_t edgeA = 0;
+    long double tA = 0.0L;
+    size_t edgeB = 0;
+    long double tB = 0.0L;
+    int pointId = -1;
+};
+
+// Result polygons stored back to back; polygon k ends at verts[ends[k]].
+struct Shapes {
+    std::vector<Point> verts;
+    std::vector<size_t> ends;
+
+    template <class It>
+    void add(It first, It last) {
+        verts.insert(verts.end(), first, last);
+        ends.push_back(verts.size());
+    }
+    void add(const Polygon& poly) { add(poly.begin(), poly.end()); }
+};
+
+// Buffers of difference_convex. Everything is cleared, never freed, so a
+// scratch reused across jobs stops allocating once it has seen the largest.
+struct DifferenceScratch {
+    std::vector<Point> idPoints;
+    PointWelder welder;
+    std::vector<int> baseIds[2];
+    std::vector<int> augmented[2];
+    std::vector<IntersectionInfo> intersections;
+    std::vector<std::vector<size_t>> perEdge[2];
+    std::vector<Edge> edges;
+    Polygon chain;
+    std::vector<ChainCrossing> crossings;
+    // Edges leaving vertex v: outgoing[firstOut[v], firstOut[v+1]).
+    std::vector<int> firstOut;
+    std::vector<int> outgoing;
+    std::vector<char> used;
+    Polygon loop;
+};
+
+void polygon_from_edge_loop(DifferenceScratch& s, int startIdx) {
+    Polygon& poly = s.loop;
+    poly.clear();
     int current = startIdx;
-    const int startVertex = edges[current].start;
+    const int startVertex = s.edges[current].start;
 
     while (true) {
-        if (used[current]) break;
-        used[current] = true;
-        const int s = edges[current].start;
-        const int e = edges[current].end;
-        poly.push_back(pts[s]);
+        if (s.used[current]) break;
+        s.used[current] = 1;
+        const int st = s.edges[current].start;
+        const int e = s.edges[current].end;
+        poly.push_back(s.idPoints[st]);
         if (e == startVertex) break;
 
         int nextEdge = -1;
-        for (int candidate : outgoing[e]) {
-            if (!used[candidate]) { nextEdge = candidate; break; }
+        for (int k = s.firstOut[e]; k < s.firstOut[e + 1]; ++k) {
+            if (!s.used[s.outgoing[k]]) { nextEdge = s.outgoing[k]; break; }
         }
         if (nextEdge == -1) break;
         current = nextEdge;
     }
     cleanup_polygon(poly);
-    return poly;
 }
 
-std::vector<Polygon> build_polygons_from_edges(const std::vector<Edge>& edges,
-                                               const std::vector<Point>& pts)
-{
-    std::vector<Polygon> result;
-    if (edges.empty()) return result;
+void build_polygons_from_edges(DifferenceScratch& s, Shapes* out) {
+    const std::vector<Edge>& edges = s.edges;
+    if (edges.empty()) return;
 
-    std::vector<std::vector<int>> outgoing(pts.size());
-    for (int i=0;i<(int)edges.size();++i) {
-        outgoing[edges[i].start].push_back(i);
-    }
-    std::vector<bool> used(edges.size(), false);
+    std::vector<int>& first = s.firstOut;
+    first.assign(s.idPoints.size() + 1, 0);
+    for (const Edge& e : edges) ++first[e.start + 1];
+    for (size_t v=1;v<first.size();++v) first[v] += first[v-1];
+    s.outgoing.resize(edges.size());
+    for (int i=0;i<(int)edges.size();++i) s.outgoing[first[edges[i].start]++] = i;
+    for (size_t v=first.size()-1;v>0;--v) first[v] = first[v-1];
+    first[0] = 0;
+
+    s.used.assign(edges.size(), 0);
     for (int i=0;i<(int)edges.size();++i) {
-        if (used[i]) continue;
-        Polygon poly = polygon_from_edge_loop(edges, pts, i, used, outgoing);
-        if (poly.size() >= 3) result.push_back(std::move(poly));
+        if (s.used[i]) continue;
+        polygon_from_edge_loop(s, i);
+        if (s.loop.size() >= 3) out->add(s.loop);
     }
-    return result;
 }
 
-struct IntersectionInfo {
-    Point p;
-    size_t edgeA = 0;
-    long double tA = 0.0L;
-    size_t edgeB = 0;
-    long double tB = 0.0L;
-    int pointId = -1;
-};
-
-std::vector<int> augment_polygon(const std::vector<int>& baseIds,
-                                 const std::vector<std::vector<size_t>>& perEdge,
-                                 const std::vector<IntersectionInfo>& inters,
-                                 bool useA)
+void augment_polygon(const std::vector<int>& baseIds,
+                     std::vector<std::vector<size_t>>& perEdge,
+                     const std::vector<IntersectionInfo>& inters,
+                     bool useA,
+                     std::vector<int>* augmented)
 {
-    std::vector<int> augmented;
+    augmented->clear();
     const size_t n = baseIds.size();
-    augmented.reserve(n * 2);
     for (size_t i=0;i<n;++i) {
-        augmented.push_back(baseIds[i]);
-        auto ids = perEdge[i];
+        augmented->push_back(baseIds[i]);
+        auto& ids = perEdge[i];
         std::sort(ids.begin(), ids.end(), [&](size_t lhs, size_t rhs){
             long double al = useA ? inters[lhs].tA : inters[lhs].tB;
             long double ar = useA ? inters[rhs].tA : inters[rhs].tB;
@@ -233,132 +557,400 @@ std::vector<int> augment_polygon(const std::vector<int>& baseIds,
         });
         for (size_t idx : ids) {
             int id = inters[idx].pointId;
-            if (id != augmented.back()) augmented.push_back(id);
+            if (id != augmented->back()) augmented->push_back(id);
         }
     }
-    return augmented;
 }
 
-std::vector<Polygon> difference_convex(const Polygon& A, const Polygon& B) {
-    std::vector<Polygon> result;
-    if (A.empty()) return result;
+void difference_convex(const Polygon& A, const Polygon& B,
+                       DifferenceScratch& s, Shapes* out)
+{
+    if (A.empty()) return;
 
-    auto classifyA0 = classify_point(B, A[0]);
-    auto classifyB0 = classify_point(A, B[0]);
+    const ConvexLocator inA(A), inB(B);
+    auto classifyA0 = inB.classify(A[0]);
+    auto classifyB0 = inA.classify(B[0]);
 
-    std::vector<Point> idPoints;
-    idPoints.reserve(A.size() + B.size());
-    std::vector<int> baseIdsA, baseIdsB;
-    baseIdsA.reserve(A.size());
-    baseIdsB.reserve(B.size());
-    for (const auto& p : A) baseIdsA.push_back(ensure_point_id(p, idPoints));
-    for (const auto& p : B) baseIdsB.push_back(ensure_point_id(p, idPoints));
+    double extent = 0.0;
+    for (const Polygon* poly : {&A, &B}) {
+        for (const auto& p : *poly) extent = std::max({extent, std::fabs(p.x), std::fabs(p.y)});
+    }
+    s.idPoints.clear();
+    s.welder.reset(&s.idPoints, extent, 2 * (A.size() + B.size()));
+    const Polygon* polys[2] = {&A, &B};
+    for (int k : {0, 1}) {
+        const Polygon& poly = *polys[k];
+        s.baseIds[k].clear();
+        for (const auto& p : poly) s.baseIds[k].push_back(s.welder.ensure_point_id(p));
+        if (s.perEdge[k].size() < poly.size()) s.perEdge[k].resize(poly.size());
+        for (size_t i=0;i<poly.size();++i) s.perEdge[k][i].clear();
+    }
 
-    std::vector<IntersectionInfo> intersections;
-    std::vector<std::vector<size_t>> intsOnA(A.size());
-    std::vector<std::vector<size_t>> intsOnB(B.size());
-    std::set<std::tuple<int,size_t,size_t>> seen;
-
-    for (size_t i=0;i<A.size();++i) {
-        Point a1 = A[i];
-        Point a2 = A[(i+1)%A.size()];
-        for (size_t j=0;j<B.size();++j) {
-            Point b1 = B[j];
-            Point b2 = B[(j+1)%B.size()];
-            Point inter;
-            long double ta = 0.0L, tb = 0.0L;
-            if (!segment_intersection(a1,a2,b1,b2, inter, ta, tb)) continue;
-            int pid = ensure_point_id(inter, idPoints);
-            auto key = std::make_tuple(pid, i, j);
-            if (seen.count(key)) continue;
-            seen.insert(key);
-            IntersectionInfo info;
-            info.p = inter;
-            info.edgeA = i;
-            info.edgeB = j;
-            info.tA = ta;
-            info.tB = tb;
-            info.pointId = pid;
-            size_t idx = intersections.size();
-            intersections.push_back(info);
-            intsOnA[i].push_back(idx);
-            intsOnB[j].push_back(idx);
+    std::vector<IntersectionInfo>& intersections = s.intersections;
+    intersections.clear();
+    auto record = [&](const Point& p, size_t i, size_t j, long double ta, long double tb) {
+        IntersectionInfo info;
+        info.p = p;
+        info.edgeA = i;
+        info.edgeB = j;
+        info.tA = ta;
+        info.tB = tb;
+        info.pointId = s.welder.ensure_point_id(p);
+        s.perEdge[0][i].push_back(intersections.size());
+        s.perEdge[1][j].push_back(intersections.size());
+        intersections.push_back(info);
+    };
+    // Position of p along the edge from `from` to `to`; only its order matters.
+    auto along = [](const Point& from, const Point& to, const Point& p) {
+        const long double dx = to.x - from.x, dy = to.y - from.y;
+        return ((p.x - from.x)*dx + (p.y - from.y)*dy) / (dx*dx + dy*dy);
+    };
+
+    // Proper crossings come from the linear walk, each once; contacts at a
+    // vertex or along an edge, and degenerate inputs, take the edge pairs.
+    const Chase chase = chase_convex(A, B, &s.chain, &s.crossings);
+    if (chase == Chase::Crossed) {
+        for (const ChainCrossing& c : s.crossings) {
+            const size_t i = (c.a + A.size() - 1) % A.size();
+            const size_t j = (c.b + B.size() - 1) % B.size();
+            record(c.p, i, j, along(A[i], A[c.a], c.p), along(B[j], B[c.b], c.p));
+        }
+    } else if (chase == Chase::Degenerate || A.size() < 3 || B.size() < 3) {
+        for (size_t i=0;i<A.size();++i) {
+            const Point& a1 = A[i];
+            const Point& a2 = A[(i+1)%A.size()];
+            for (size_t j=0;j<B.size();++j) {
+                Point inter;
+                long double ta = 0.0L, tb = 0.0L;
+                if (!segment_intersection(a1, a2, B[j], B[(j+1)%B.size()], inter, ta, tb)) continue;
+                record(inter, i, j, ta, tb);
+            }
         }
     }
 
     if (intersections.empty()) {
-        if (classifyA0 != PointClass::Outside && classifyB0 != PointClass::Outside) {
-            return result;
-        }
-        if (classifyA0 != PointClass::Outside) {
-            return result;
-        }
-        if (classifyB0 != PointClass::Outside) {
-            Polygon hole = B;
-            std::reverse(hole.begin(), hole.end());
-            result.push_back(A);
-            result.push_back(std::move(hole));
-            return result;
-        }
-        result.push_back(A);
-        return result;
+        if (classifyA0 != PointClass::Outside) return;
+        out->add(A);
+        if (classifyB0 != PointClass::Outside) out->add(B.rbegin(), B.rend());
+        return;
     }
 
-    auto augmentedA = augment_polygon(baseIdsA, intsOnA, intersections, true);
-    auto augmentedB = augment_polygon(baseIdsB, intsOnB, intersections, false);
+    augment_polygon(s.baseIds[0], s.perEdge[0], intersections, true, &s.augmented[0]);
+    augment_polygon(s.baseIds[1], s.perEdge[1], intersections, false, &s.augmented[1]);
 
     auto addEdges = [&](const std::vector<int>& augmented,
-                        const Polygon& polyOther,
+                        const ConvexLocator& polyOther,
                         bool reverse,
-                        PointClass desired) -> std::vector<Edge>
+                        PointClass desired)
     {
-        std::vector<Edge> edges;
-        if (augmented.empty()) return edges;
         for (size_t i=0;i<augmented.size();++i) {
-            int s = augmented[i];
+            int st = augmented[i];
             int e = augmented[(i+1)%augmented.size()];
-            if (s == e) continue;
-            const Point& ps = idPoints[s];
-            const Point& pe = idPoints[e];
-            Point mid{ (ps.x + pe.x) * 0.5L, (ps.y + pe.y) * 0.5L };
-            PointClass cls = classify_point(polyOther, mid);
+            if (st == e) continue;
+            const Point& ps = s.idPoints[st];
+            const Point& pe = s.idPoints[e];
+            Point mid{ (ps.x + pe.x) * 0.5, (ps.y + pe.y) * 0.5 };
+            PointClass cls = polyOther.classify(mid);
             bool take = (desired == PointClass::Outside) ? (cls == PointClass::Outside)
                                                         : (cls != PointClass::Outside);
             if (!take) continue;
-            if (reverse) edges.push_back(Edge{e,s});
-            else edges.push_back(Edge{s,e});
+            if (reverse) s.edges.push_back(Edge{e,st});
+            else s.edges.push_back(Edge{st,e});
         }
-        return edges;
     };
 
-    std::vector<Edge> edges;
-    auto aEdges = addEdges(augmentedA, B, false, PointClass::Outside);
-    auto bEdges = addEdges(augmentedB, A, true, PointClass::Inside);
-    edges.reserve(aEdges.size() + bEdges.size());
-    edges.insert(edges.end(), aEdges.begin(), aEdges.end());
-    edges.insert(edges.end(), bEdges.begin(), bEdges.end());
+    s.edges.clear();
+    addEdges(s.augmented[0], inB, false, PointClass::Outside);
+    addEdges(s.augmented[1], inA, true, PointClass::Inside);
+    build_polygons_from_edges(s, out);
+}
 
-    result = build_polygons_from_edges(edges, idPoints);
-    return result;
+// Everything one job needs besides its inputs; one per worker.
+struct Workspace {
+    Polygon A;
+    Polygon B;
+    Polygon inter;
+    Polygon outline;
+    std::vector<ChainCrossing> crossings;
+    DifferenceScratch diff;
+};
+
+// Angular order of points around c, starting at the ray c -> ref, by exact
+// orientation signs; c must differ from every point compared.
+class Around {
+public:
+    Around(const Point& c, const Point& ref) : c_(c), ref_(ref) {}
+
+    bool before(const Point& p, const Point& q) const {
+        const int hp = half(p), hq = half(q);
+        if (hp != hq) return hp < hq;
+        return common::orient2d(c_, p, q) > 0.0;
+    }
+
+    // For p and q on one ray: 1 when p is farther from c, -1 when nearer.
+    int farther(const Point& p, const Point& q) const {
+        if (p.x != c_.x) return p.x > c_.x ? (p.x > q.x) - (p.x < q.x) : (p.x < q.x) - (p.x > q.x);
+        return p.y > c_.y ? (p.y > q.y) - (p.y < q.y) : (p.y < q.y) - (p.y > q.y);
+    }
+
+private:
+    // 0 for angles in [0, pi) from the reference ray, 1 for [pi, 2pi).
+    int half(const Point& p) const {
+        const double o = common::orient2d(c_, ref_, p);
+        if (o != 0.0) return o > 0.0 ? 0 : 1;
+        const bool ahead = ref_.x != c_.x ? (p.x > c_.x) == (ref_.x > c_.x)
+                                          : (p.y > c_.y) == (ref_.y > c_.y);
+        return ahead ? 0 : 1;
+    }
+
+    Point c_;
+    Point ref_;
+};
+
+bool strictly_inside_convex(const Polygon& poly, const Point& p) {
+    for (size_t i = 0; i < poly.size(); ++i) {
+        if (common::orient2d(poly[i], poly[(i+1) % poly.size()], p) <= 0.0) return false;
+    }
+    return true;
 }
 
-inline std::vector<Polygon> union_convex(const Polygon& A, const Polygon& B) {
-    std::vector<Polygon> res = difference_convex(A,B);
-    std::vector<Polygon> bma = difference_convex(B,A);
-    Polygon inter = intersection_convex(A,B);
-    res.insert(res.end(),
-               std::make_move_iterator(bma.begin()),
-               std::make_move_iterator(bma.end()));
-    if (!inter.empty()) res.push_back(std::move(inter));
-    if (res.empty()) res.push_back(A);
-    return res;
+// A point strictly inside both polygons, from the middle of their
+// intersection or of its widest fan triangle. False when rounding leaves
+// no such point, i.e. the overlap is thinner than the coordinates resolve.
+bool common_interior(const Polygon& A, const Polygon& B, const Polygon& inter, Point* c) {
+    long double sx = 0.0L, sy = 0.0L;
+    for (const Point& p : inter) {
+        sx += p.x;
+        sy += p.y;
+    }
+    const long double k = static_cast<long double>(inter.size());
+    size_t wide = 1;
+    for (size_t i = 2; i + 1 < inter.size(); ++i) {
+        if (cross(inter[0], inter[i], inter[i+1]) > cross(inter[0], inter[wide], inter[wide+1])) wide = i;
+    }
+    const Point& t0 = inter[0];
+    const Point& t1 = inter[wide];
+    const Point& t2 = inter[wide+1];
+    const Point candidates[2] = {
+        Point{static_cast<double>(sx / k), static_cast<double>(sy / k)},
+        Point{static_cast<double>((static_cast<long double>(t0.x) + t1.x + t2.x) / 3.0L),
+              static_cast<double>((static_cast<long double>(t0.y) + t1.y + t2.y) / 3.0L)},
+    };
+    for (const Point& p : candidates) {
+        if (strictly_inside_convex(A, p) && strictly_inside_convex(B, p)) {
+            *c = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Union outline of two convex polygons around a point c strictly inside
+// both. Every ray from c leaves each polygon once, and the union reaches
+// the farther exit, so merging the vertices of A and B by angle and keeping
+// the outer one at each ray traces the outline in one pass; where the outer
+// polygon changes inside a wedge, the two spanning edges cross. Vertices on
+// the other boundary and shared edges are ties: the point is kept once and
+// cleanup_polygon drops it if it turns out collinear.
+void outer_outline(const Polygon& A, const Polygon& B, const Point& c, Polygon* out) {
+    out->clear();
+    const size_t n = A.size(), m = B.size();
+    const Around around(c, A[0]);
+    size_t j0 = 0;
+    for (size_t j = 1; j < m; ++j) {
+        if (around.before(B[j], B[j0])) j0 = j;
+    }
+    auto at_a = [&](size_t i) -> const Point& { return A[i % n]; };
+    auto at_b = [&](size_t j) -> const Point& { return B[(j0 + j) % m]; };
+
+    // side > 0: A is outer on the current ray, < 0: B is, 0: they meet.
+    int first = 0, last = 0;
+    size_t i = 0, j = 0;
+    while (i < n || j < m) {
+        // The edges spanning the wedge that ends at this ray.
+        const Point& a1 = at_a(i + n - 1);
+        const Point& a2 = at_a(i);
+        const Point& b1 = at_b(j + m - 1);
+        const Point& b2 = at_b(j);
+        const bool take_a = j == m || (i < n && !around.before(b2, a2));
+        const bool take_b = i == n || (j < m && !around.before(a2, b2));
+
+        int side;
+        if (take_a && take_b) side = around.farther(a2, b2);
+        else if (take_a) side = -sign(common::orient2d(b1, b2, a2));
+        else side = sign(common::orient2d(a1, a2, b2));
+
+        if (i + j == 0) first = side;
+        else if (side * last < 0) out->push_back(seg_intersect(a1, a2, b1, b2));
+        if (take_a && side >= 0) out->push_back(a2);
+        else if (take_b && side <= 0) out->push_back(b2);
+        last = side;
+        if (take_a) ++i;
+        if (take_b) ++j;
+    }
+    // The last wedge closes at the ray through A[0].
+    if (first * last < 0) out->push_back(seg_intersect(A[n-1], A[0], at_b(m - 1), at_b(0)));
+    cleanup_polygon(*out);
+}
+
+// Union outline from a chase in general position: between consecutive
+// crossings it follows whichever boundary runs outside the other, so each
+// vertex is visited once.
+void crossing_outline(const Polygon& A, const Polygon& B,
+                      const std::vector<ChainCrossing>& crossings, Polygon* out)
+{
+    out->clear();
+    for (size_t k = 0; k < crossings.size(); ++k) {
+        const ChainCrossing& from = crossings[k];
+        const ChainCrossing& to = crossings[(k + 1) % crossings.size()];
+        const Polygon& P = from.a_inside ? B : A;
+        const size_t first = from.a_inside ? from.b : from.a;
+        const size_t last = from.a_inside ? to.b : to.a;
+        const size_t size = P.size();
+
+        size_t count = (last + size - first) % size;
+        if (count == 0) {
+            // Both crossings sit on one edge: nothing between them, or the
+            // whole polygon when the next one lies behind.
+            const Point& tail = P[(first + size - 1) % size];
+            const long double dx = P[first].x - tail.x, dy = P[first].y - tail.y;
+            if ((to.p.x - from.p.x)*dx + (to.p.y - from.p.y)*dy < 0.0L) count = size;
+        }
+        out->push_back(from.p);
+        for (size_t i = 0; i < count; ++i) out->push_back(P[(first + i) % size]);
+    }
+    cleanup_polygon(*out);
+}
+
+// Collinear edges a1a2 and b1b2 that run opposite ways and overlap in more
+// than a point. Coordinates along the dominant axis of a1a2 are compared
+// exactly.
+bool opposite_overlap(const Point& a1, const Point& a2, const Point& b1, const Point& b2) {
+    if (common::orient2d(a1, a2, b1) != 0.0 || common::orient2d(a1, a2, b2) != 0.0) return false;
+    const bool by_x = std::fabs(a2.x - a1.x) >= std::fabs(a2.y - a1.y);
+    const double sa = by_x ? a1.x : a1.y, ea = by_x ? a2.x : a2.y;
+    const double sb = by_x ? b1.x : b1.y, eb = by_x ? b2.x : b2.y;
+    if ((ea > sa) == (eb > sb) || eb == sb) return false;
+    return std::min(std::max(sa, ea), std::max(sb, eb)) > std::max(std::min(sa, ea), std::min(sb, eb));
+}
+
+// Edge i of A and edge j of B when B touches A from outside along a stretch
+// of positive length. The B vertex farthest left of A's edge i only moves
+// forward as i does, so one rotating pass finds the pair; the edges on both
+// sides of that vertex are tested, as a parallel edge leaves a tie.
+bool shared_edge(const Polygon& A, const Polygon& B, size_t* ia, size_t* jb) {
+    const size_t n = A.size(), m = B.size();
+    auto height = [&](size_t i, size_t j) {
+        return common::orient2d(A[i], A[(i+1) % n], B[j % m]);
+    };
+    size_t j = 0;
+    for (size_t k = 1; k < m; ++k) {
+        if (height(0, k) > height(0, j)) j = k;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t step = 0; step < m && height(i, j + 1) > height(i, j); ++step) j = (j + 1) % m;
+        for (size_t k : {j + m - 1, j}) {
+            if (opposite_overlap(A[i], A[(i+1) % n], B[k % m], B[(k+1) % m])) {
+                *ia = i;
+                *jb = k % m;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Union of polygons that meet only along edge i of A and edge j of B: A
+// from the head of its edge round to its tail, then B likewise. The shared
+// stretch is skipped and cleanup_polygon drops the points left on a line.
+void joined_outline(const Polygon& A, const Polygon& B, size_t i, size_t j, Polygon* out) {
+    out->clear();
+    for (size_t k = 1; k <= A.size(); ++k) out->push_back(A[(i + k) % A.size()]);
+    for (size_t k = 1; k <= B.size(); ++k) out->push_back(B[(j + k) % B.size()]);
+    cleanup_polygon(*out);
+}
+
+// One outline whenever the interiors overlap or the polygons share part of
+// an edge. Proper crossings only take the crossing walk; vertex contacts
+// and overlapping edges go around a common interior point, or join along
+// the shared edge when the interiors are apart. Polygons that touch at
+// points only, or are apart, stay two pieces.
+void union_convex(const Polygon& A, const Polygon& B, Workspace& ws, Shapes* out) {
+    switch (chase_convex(A, B, &ws.inter, &ws.crossings)) {
+    case Chase::Crossed:
+        crossing_outline(A, B, ws.crossings, &ws.outline);
+        out->add(ws.outline);
+        return;
+    case Chase::Degenerate: {
+        Point c;
+        if (clip_convex(A, B, &ws.inter) && common_interior(A, B, ws.inter, &c)) {
+            outer_outline(A, B, c, &ws.outline);
+            out->add(ws.outline);
+            return;
+        }
+        size_t i = 0, j = 0;
+        if (ws.inter.empty() && shared_edge(A, B, &i, &j)) {
+            joined_outline(A, B, i, j, &ws.outline);
+            out->add(ws.outline);
+            return;
+        }
+        break;
+    }
+    default:
+        if (inside_convex(B, A[0])) {
+            out->add(B);
+            return;
+        }
+        if (inside_convex(A, B[0])) {
+            out->add(A);
+            return;
+        }
+        break;
+    }
+    out->add(A);
+    out->add(B);
+}
+
+// Inputs that are clockwise are reversed into the workspace; the others are
+// used in place.
+void run_job(const Polygon& hullA, const Polygon& hullB, Operation op,
+             Workspace& ws, Shapes* out)
+{
+    if (hullA.empty() || hullB.empty()) return;
+    auto oriented = [](const Polygon& p, Polygon& copy) -> const Polygon& {
+        if (ccw(p)) return p;
+        copy.assign(p.rbegin(), p.rend());
+        return copy;
+    };
+    const Polygon& A = oriented(hullA, ws.A);
+    const Polygon& B = oriented(hullB, ws.B);
+
+    switch (op) {
+    case Operation::Intersection:
+        if (clip_convex(A, B, &ws.inter)) out->add(ws.inter);
+        break;
+    case Operation::DifferenceAB:
+        difference_convex(A, B, ws.diff, out);
+        break;
+    case Operation::Union:
+        union_convex(A, B, ws, out);
+        break;
+    }
 }
 }
 
 Polygon convex_hull(const std::vector<Point>& pts) {
     if (pts.empty()) return {};
 
-    std::vector<Point> sorted = pts;
+    common::ExtremeOctagon oct;
+    for (const auto& p : pts) oct.add(p.x, p.y);
+    oct.close();
+
+    std::vector<Point> sorted;
+    sorted.reserve(pts.size());
+    for (const auto& p : pts) {
+        if (!oct.inside(p.x, p.y)) sorted.push_back(p);
+    }
     std::sort(sorted.begin(), sorted.end(), [](const Point& a, const Point& b){
         if (a.x < b.x) return true;
         if (a.x > b.x) return false;
@@ -381,7 +973,7 @@ Polygon convex_hull(const std::vector<Point>& pts) {
         while (st.size() >= 2) {
             Point p2 = st.back(); st.pop_back();
             Point p1 = st.back();
-            if (cross(p1,p2,pt) > 0.0L) { st.push_back(p2); break; }
+            if (common::orient2d(p1,p2,pt) > 0.0) { st.push_back(p2); break; }
         }
         st.push_back(pt);
     }
@@ -392,7 +984,7 @@ Polygon convex_hull(const std::vector<Point>& pts) {
         while (st.size() > lower) {
             Point p2 = st.back(); st.pop_back();
             Point p1 = st.back();
-            if (cross(p1,p2,pt) > 0.0L) { st.push_back(p2); break; }
+            if (common::orient2d(p1,p2,pt) > 0.0) { st.push_back(p2); break; }
         }
         st.push_back(pt);
     }
@@ -401,27 +993,80 @@ Polygon convex_hull(const std::vector<Point>& pts) {
     return st;
 }
 
+bool intersect_convex(const Polygon& A, const Polygon& B, Polygon* out) {
+    return clip_convex(A, B, out);
+}
+
 std::vector<Polygon> boolean_operation(const Polygon& hullA,
                                        const Polygon& hullB,
                                        Operation op)
 {
-    Polygon A = hullA;
-    Polygon B = hullB;
-    if (A.empty() || B.empty()) return {};
+    Workspace ws;
+    Shapes shapes;
+    run_job(hullA, hullB, op, ws, &shapes);
+
+    std::vector<Polygon> result;
+    result.reserve(shapes.ends.size());
+    size_t from = 0;
+    for (size_t end : shapes.ends) {
+        result.emplace_back(shapes.verts.begin() + static_cast<std::ptrdiff_t>(from),
+                            shapes.verts.begin() + static_cast<std::ptrdiff_t>(end));
+        from = end;
+    }
+    return result;
+}
 
-    if (!ccw(A)) std::reverse(A.begin(), A.end());
-    if (!ccw(B)) std::reverse(B.begin(), B.end());
+void boolean_operations(const std::vector<BooleanJob>& jobs, BooleanBatch* out, int threads) {
+    constexpr size_t kBlock = 256;
+    const size_t blocks = (jobs.size() + kBlock - 1) / kBlock;
+    const int workers = static_cast<int>(std::max<size_t>(1,
+        std::min(blocks, static_cast<size_t>(common::resolve_threads(threads)))));
 
-    if (op == Operation::Intersection) {
-        Polygon inter = intersection_convex(A,B);
-        if (inter.empty()) return {};
-        return { std::move(inter) };
+    // Each worker appends to its own shapes; a job remembers where its
+    // polygons landed so the merge below can restore job order.
+    struct Placement {
+        int worker = 0;
+        size_t first = 0;
+        size_t last = 0;
+    };
+    std::vector<Workspace> spaces(static_cast<size_t>(workers));
+    std::vector<Shapes> shapes(static_cast<size_t>(workers));
+    std::vector<Placement> placed(jobs.size());
+    common::parallel_for(blocks, workers, [&](size_t b, int w) {
+        Shapes& mine = shapes[w];
+        const size_t to = std::min(jobs.size(), (b + 1) * kBlock);
+        for (size_t j = b * kBlock; j < to; ++j) {
+            const BooleanJob& job = jobs[j];
+            const size_t first = mine.ends.size();
+            if (job.a && job.b) run_job(*job.a, *job.b, job.op, spaces[w], &mine);
+            placed[j] = Placement{w, first, mine.ends.size()};
+        }
+    });
+
+    size_t vertices = 0, polygons = 0;
+    for (const Shapes& s : shapes) {
+        vertices += s.verts.size();
+        polygons += s.ends.size();
     }
-    if (op == Operation::DifferenceAB) {
-        return difference_convex(A,B);
+    out->vertices.clear();
+    out->vertices.reserve(vertices);
+    out->polygons.clear();
+    out->polygons.reserve(polygons + 1);
+    out->polygons.push_back(0);
+    out->jobs.clear();
+    out->jobs.reserve(jobs.size() + 1);
+    out->jobs.push_back(0);
+    for (const Placement& p : placed) {
+        const Shapes& s = shapes[p.worker];
+        for (size_t k = p.first; k < p.last; ++k) {
+            const size_t from = k > 0 ? s.ends[k - 1] : 0;
+            out->vertices.insert(out->vertices.end(),
+                                 s.verts.begin() + static_cast<std::ptrdiff_t>(from),
+                                 s.verts.begin() + static_cast<std::ptrdiff_t>(s.ends[k]));
+            out->polygons.push_back(out->vertices.size());
+        }
+        out->jobs.push_back(out->polygons.size() - 1);
     }
-
-    return union_convex(A,B);
 }
 
 } 
@@ -0,0 +1,251 @@
+#include "task789/convex_contact.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/parallel.hpp"
+#include "common/predicates.hpp"
+
+namespace task789 {
+namespace {
+inline long double cross(long double ax, long double ay, long double bx, long double by) {
+    return ax*by - ay*bx;
+}
+
+// 0 for directions in [0, pi), 1 for [pi, 2pi).
+inline int half(long double x, long double y) {
+    return (y > 0.0L || (y == 0.0L && x > 0.0L)) ? 0 : 1;
+}
+
+// Sign of f*(b - a); comparisons keep it exact.
+inline int sign_step(double a, double b, double f) {
+    const int d = (b > a) - (b < a);
+    return f < 0.0 ? -d : d;
+}
+
+// Lowest vertex, leftmost among equals. With `flip` the highest, rightmost
+// one, which is the lowest vertex of the reflected polygon.
+size_t bottom(const Polygon& P, bool flip) {
+    const long double s = flip ? -1.0L : 1.0L;
+    size_t best = 0;
+    for (size_t i = 1; i < P.size(); ++i) {
+        const Point& p = P[i];
+        const Point& b = P[best];
+        if (s*p.y < s*b.y || (p.y == b.y && s*p.x < s*b.x)) best = i;
+    }
+    return best;
+}
+
+// Walks the edges of A + B, or of A - B = A + (-B) with `minus`, in angular
+// order from the lowest vertices, merging the two edge lists. Every edge of
+// the result is an edge e1 -> e2 of one polygon taken at the vertex v of the
+// other (A's edges with B's vertices, or the reverse); the walk passes the
+// result's vertex e1 +- v, or v +- e1, at its start. For the difference v
+// supports the edge from outside, so the origin lies inside A - B exactly
+// when each v is left of (or on) its edge. visit(e1, e2, v, from_a) returns
+// false to stop the walk.
+template <class Visit>
+bool walk(const Polygon& A, const Polygon& B, bool minus, Visit&& visit) {
+    const size_t n = A.size(), m = B.size();
+    const long double s = minus ? -1.0L : 1.0L;
+    size_t i = bottom(A, false), j = bottom(B, minus);
+    size_t done_a = 0, done_b = 0;
+    while (done_a < n || done_b < m) {
+        const Point& a1 = A[i];
+        const Point& a2 = A[(i + 1) % n];
+        const Point& b1 = B[j];
+        const Point& b2 = B[(j + 1) % m];
+        bool take_a = done_b == m;
+        if (done_a < n && done_b < m) {
+            // Angles from the lowest vertices span [0, 2pi), so halves
+            // first, then the exact turn between them; parallel edges take
+            // A first.
+            const long double ax = a2.x - a1.x, ay = a2.y - a1.y;
+            const long double bx = s*(b2.x - b1.x), by = s*(b2.y - b1.y);
+            const int ha = half(ax, ay), hb = half(bx, by);
+            take_a = ha != hb ? ha < hb : s*common::cross2d(a1, a2, b1, b2) >= 0.0L;
+        }
+        if (take_a) {
+            if (!visit(a1, a2, b1, true)) return false;
+            i = (i + 1) % n;
+            ++done_a;
+        } else {
+            if (!visit(b1, b2, a1, false)) return false;
+            j = (j + 1) % m;
+            ++done_b;
+        }
+    }
+    return true;
+}
+
+bool contact(const Polygon& A, const Polygon& B, ConvexContact* out) {
+    *out = ConvexContact{};
+    if (A.size() < 3 || B.size() < 3) return false;
+
+    // Candidates are compared as num / den without dividing; only the
+    // winner is normalised.
+    struct Best {
+        long double num = -1.0L;
+        long double den = 1.0L;
+        long double x = 0.0L;
+        long double y = 0.0L;
+
+        void offer(long double n, long double d, long double nx, long double ny) {
+            if (num < 0.0L || n*den < num*d) *this = Best{n, d, nx, ny};
+        }
+    };
+
+    // The depth is the smallest distance from v to its edge's line; the
+    // first separating edge ends this pass.
+    Best best;
+    const bool overlap = walk(A, B, true, [&](const Point& e1, const Point& e2, const Point& v, bool from_a) {
+        if (common::orient2d(e1, e2, v) < 0.0) return false;
+        const long double ex = e2.x - e1.x, ey = e2.y - e1.y;
+        const long double len2 = ex*ex + ey*ey;
+        if (len2 == 0.0L) return true;
+        // Outward normal of this edge of the difference; edges of B run
+        // backwards there.
+        const long double f = from_a ? 1.0L : -1.0L;
+        const long double c = std::max(0.0L, cross(ex, ey, v.x - e1.x, v.y - e1.y));
+        best.offer(c*c, len2, f*ey, -f*ex);
+        return true;
+    });
+
+    // Outside, the distance to the difference is the distance to its
+    // nearest edge, i.e. from v to the closest point of e1e2. Taking every
+    // edge rather than the separating ones keeps near contacts close to zero
+    // whichever way their orientation tests round.
+    if (!overlap) {
+        best = Best{};
+        walk(A, B, true, [&](const Point& e1, const Point& e2, const Point& v, bool from_a) {
+            const long double f = from_a ? 1.0L : -1.0L;
+            const long double ex = e2.x - e1.x, ey = e2.y - e1.y;
+            const long double len2 = ex*ex + ey*ey;
+            const long double vx = v.x - e1.x, vy = v.y - e1.y;
+            const long double along = vx*ex + vy*ey;
+            if (along <= 0.0L || len2 == 0.0L) {
+                best.offer(vx*vx + vy*vy, 1.0L, f*vx, f*vy);
+            } else if (along >= len2) {
+                const long double wx = v.x - e2.x, wy = v.y - e2.y;
+                best.offer(wx*wx + wy*wy, 1.0L, f*wx, f*wy);
+            } else {
+                const long double c = cross(ex, ey, vx, vy);
+                best.offer(c*c, len2, f*ey, -f*ex);
+            }
+            return true;
+        });
+    }
+
+    out->overlap = overlap;
+    out->depth = std::sqrt(best.num / best.den) * (overlap ? 1.0L : -1.0L);
+    const long double len = std::sqrt(best.x*best.x + best.y*best.y);
+    if (len > 0.0L) out->normal = Point{static_cast<double>(best.x / len), static_cast<double>(best.y / len)};
+    return overlap;
+}
+
+// Emits the vertex at the start of every edge of the walk, except where the
+// edge only continues the previous one (parallel edges of A and B, or
+// collinear input vertices) or has no length. Both tests are made on the
+// input points, so nearly parallel edges keep their vertex and exactly
+// parallel ones never do.
+bool minkowski(const Polygon& A, const Polygon& B, bool minus, Polygon* out) {
+    out->clear();
+    if (A.empty() || B.empty()) return false;
+    const double s = minus ? -1.0 : 1.0;
+    const Point* p1 = nullptr;
+    const Point* p2 = nullptr;
+    double pf = 1.0;
+    walk(A, B, minus, [&](const Point& e1, const Point& e2, const Point& v, bool from_a) {
+        if (e1.x == e2.x && e1.y == e2.y) return true;
+        const double f = from_a ? 1.0 : s;
+        const bool straight = p1 && common::cross2d(*p1, *p2, e1, e2) == 0.0 &&
+                              sign_step(p1->x, p2->x, pf) == sign_step(e1.x, e2.x, f) &&
+                              sign_step(p1->y, p2->y, pf) == sign_step(e1.y, e2.y, f);
+        p1 = &e1;
+        p2 = &e2;
+        pf = f;
+        if (straight) return true;
+        const Point& a = from_a ? e1 : v;
+        const Point& b = from_a ? v : e1;
+        out->push_back(Point{a.x + s*b.x, a.y + s*b.y});
+        return true;
+    });
+    if (out->empty()) out->push_back(Point{A[0].x + s*B[0].x, A[0].y + s*B[0].y});
+    return true;
+}
+
+void minkowski_batch(const std::vector<Polygon>& As, const Polygon& B, bool minus,
+                     std::vector<Polygon>* out, int threads)
+{
+    constexpr size_t kBlock = 256;
+    out->resize(As.size());
+    const size_t blocks = (As.size() + kBlock - 1) / kBlock;
+    common::parallel_for(blocks, threads, [&](size_t b, int) {
+        const size_t to = std::min(As.size(), (b + 1) * kBlock);
+        for (size_t k = b * kBlock; k < to; ++k) minkowski(As[k], B, minus, &(*out)[k]);
+    });
+}
+
+template <class Result, class Query>
+void batch(const std::vector<PolygonPair>& pairs, std::vector<Result>* out, int threads,
+           Query query)
+{
+    constexpr size_t kBlock = 1024;
+    out->assign(pairs.size(), Result{});
+    const size_t blocks = (pairs.size() + kBlock - 1) / kBlock;
+    common::parallel_for(blocks, threads, [&](size_t b, int) {
+        const size_t to = std::min(pairs.size(), (b + 1) * kBlock);
+        for (size_t k = b * kBlock; k < to; ++k) {
+            if (!pairs[k].a || !pairs[k].b) continue;
+            query(*pairs[k].a, *pairs[k].b, &(*out)[k]);
+        }
+    });
+}
+}
+
+bool convex_overlap(const Polygon& A, const Polygon& B) {
+    if (A.size() < 3 || B.size() < 3) return false;
+    return walk(A, B, true, [](const Point& e1, const Point& e2, const Point& v, bool) {
+        return common::orient2d(e1, e2, v) >= 0.0;
+    });
+}
+
+bool convex_contact(const Polygon& A, const Polygon& B, ConvexContact* out) {
+    return contact(A, B, out);
+}
+
+void convex_overlaps(const std::vector<PolygonPair>& pairs, std::vector<char>* out,
+                     int threads)
+{
+    batch(pairs, out, threads, [](const Polygon& A, const Polygon& B, char* r) {
+        *r = convex_overlap(A, B) ? 1 : 0;
+    });
+}
+
+void convex_contacts(const std::vector<PolygonPair>& pairs, std::vector<ConvexContact>* out,
+                     int threads)
+{
+    batch(pairs, out, threads, contact);
+}
+
+bool minkowski_sum(const Polygon& A, const Polygon& B, Polygon* out) {
+    return minkowski(A, B, false, out);
+}
+
+bool minkowski_difference(const Polygon& A, const Polygon& B, Polygon* out) {
+    return minkowski(A, B, true, out);
+}
+
+void minkowski_sums(const std::vector<Polygon>& As, const Polygon& B,
+                    std::vector<Polygon>* out, int threads)
+{
+    minkowski_batch(As, B, false, out, threads);
+}
+
+void minkowski_differences(const std::vector<Polygon>& As, const Polygon& B,
+                           std::vector<Polygon>* out, int threads)
+{
+    minkowski_batch(As, B, true, out, threads);
+}
+
+} 
@@ -233,7 +233,9 @@ void PolyBoolModel::rebuildResult() {
     task10::Operation op = task10::Operation::Intersection;
     if (mode_ == PolyBoolMode::Union) op = task10::Operation::Union;
     else if (mode_ == PolyBoolMode::Difference) op = task10::Operation::DifferenceAB;
-    const auto polys = task10::boolean_operation(pa, pb, op);
+    session_.set_a(pa);
+    session_.set_b(pb);
+    const auto polys = session_.execute(op);
     result_.clear();
     for (const auto& poly : polys) {
         for (const auto& loop : poly.loops) {
@@ -88,6 +88,8 @@ private:
     PolyBoolMode mode_ = PolyBoolMode::Intersection;
     mutable VertexRef activeHandle_;
 
+    // Keeps the converted input that did not change between rebuilds.
+    task10::BooleanSession session_;
     std::vector<ResultLoop> result_;
     std::vector<Outline> outlinesA_;
     std::vector<Outline> outlinesB_;
@@ -1,22 +1,25 @@
 #include "canvas_model.h"
 
-int CanvasModel::addPoint(const LDPoint& p) {
+int CanvasModel::addPoint(const Point& p) {
     pts_.push_back(p);
+    dynamic_.insert(p);
     return static_cast<int>(pts_.size()) - 1;
 }
 
-void CanvasModel::setPoint(int idx, const LDPoint& p) {
+void CanvasModel::setPoint(int idx, const Point& p) {
     if (idx < 0 || idx >= static_cast<int>(pts_.size())) return;
     pts_[idx] = p;
+    dynamic_.move(idx, p);
 }
 
 void CanvasModel::clear() {
     pts_.clear();
     hull_.clear();
+    dynamic_.clear();
 }
 
 bool CanvasModel::computeHull() {
-    if (!task4::convex_hull_indices(pts_, &hull_)) {
+    if (!dynamic_.hull(&hull_)) {
         hull_.clear();
         return false;
     }
@@ -3,14 +3,14 @@
 #include <QPointF>
 #include <task4/convex_hull.hpp>
 
-using LDPoint = task4::Point;
+using Point = task4::Point;
 
 class CanvasModel {
 public:
     
-    int  addPoint(const LDPoint& p);                  
-    void setPoint(int idx, const LDPoint& p);         
-    const std::vector<LDPoint>& points() const { return pts_; }
+    int  addPoint(const Point& p);                  
+    void setPoint(int idx, const Point& p);         
+    const std::vector<Point>& points() const { return pts_; }
     void clear();
 
     
@@ -25,6 +25,7 @@ public:
     size_t size() const { return pts_.size(); }
 
 private:
-    std::vector<LDPoint> pts_;
+    std::vector<Point> pts_;
     std::vector<int> hull_; 
+    task4::DynamicHull dynamic_;
 };
@@ -97,7 +97,7 @@ void CanvasWidget::mousePressEvent(QMouseEvent *event) {
         }
     }
     
-    model_.addPoint({ (long double)w.x(), (long double)w.y() });
+    model_.addPoint({ w.x(), w.y() });
 
     if (live_) {
         model_.computeHull();
@@ -111,7 +111,7 @@ void CanvasWidget::mouseMoveEvent(QMouseEvent *event) {
     const QPointF m = mousePointF(event);
     const QPointF w = screenToWorld(m);
     if (dragIndex_ >= 0) {
-        model_.setPoint(dragIndex_, { (long double)w.x(), (long double)w.y() });
+        model_.setPoint(dragIndex_, { w.x(), w.y() });
         model_.computeHull();
         emit hullStatus((int)model_.size(), (int)model_.hullIndices().size());
         update();
@@ -162,8 +162,8 @@ void CanvasWidget::paintEvent(QPaintEvent *) {
         const auto& ids = model_.hullIndices();
         const auto& pts = model_.points();
         for (int i=0; i<(int)ids.size(); ++i) {
-            const LDPoint &A = pts[ ids[i] ];
-            const LDPoint &B = pts[ ids[(i+1)%ids.size()] ];
+            const Point &A = pts[ ids[i] ];
+            const Point &B = pts[ ids[(i+1)%ids.size()] ];
             p.drawLine(QPointF((double)A.x, (double)A.y),
                        QPointF((double)B.x, (double)B.y));
         }
@@ -1,20 +1,28 @@
 #include "canvas_model.h"
 
-int CanvasModel::addPoint(const LDPoint& p) {
+int CanvasModel::addPoint(const Point& p) {
     pts_.push_back(p);
+    mesh_.insert(p);
     return static_cast<int>(pts_.size()) - 1;
 }
 
-void CanvasModel::setPoint(int idx, const LDPoint& p) {
+void CanvasModel::setPoint(int idx, const Point& p) {
     if (idx < 0 || idx >= static_cast<int>(pts_.size())) return;
     pts_[idx] = p;
+    mesh_.move(idx, p);
 }
 
 void CanvasModel::clear() {
     pts_.clear();
     tris_.clear();
+    mesh_.clear();
 }
 
 bool CanvasModel::computeDelaunay() {
-    return task5::delaunay_triangulation(pts_, &tris_);
+    if (pts_.size() < 2) {
+        tris_.clear();
+        return false;
+    }
+    mesh_.triangles(&tris_);
+    return true;
 }
@@ -3,15 +3,15 @@
 #include <QPointF>
 #include <task5/delaunay.hpp>
 
-using LDPoint = task5::Point;
+using Point = task5::Point;
 using Triangle = task5::Triangle;
 
 class CanvasModel {
 public:
     
-    int  addPoint(const LDPoint& p);               
-    void setPoint(int idx, const LDPoint& p);      
-    const std::vector<LDPoint>& points() const { return pts_; }
+    int  addPoint(const Point& p);               
+    void setPoint(int idx, const Point& p);      
+    const std::vector<Point>& points() const { return pts_; }
     void clear();
 
     
@@ -25,6 +25,7 @@ public:
     size_t size() const { return pts_.size(); }
 
 private:
-    std::vector<LDPoint> pts_;
+    std::vector<Point> pts_;
     std::vector<Triangle> tris_;
+    task5::DelaunayMesh mesh_;
 };
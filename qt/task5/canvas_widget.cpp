@@ -97,7 +97,7 @@ void CanvasWidget::mousePressEvent(QMouseEvent *event) {
         }
     }
     
-    model_.addPoint({ (long double)w.x(), (long double)w.y() });
+    model_.addPoint({ w.x(), w.y() });
 
     if (live_) {
         model_.computeDelaunay();
@@ -111,7 +111,7 @@ void CanvasWidget::mouseMoveEvent(QMouseEvent *event) {
     const QPointF m = mousePointF(event);
     const QPointF w = screenToWorld(m);
     if (dragIndex_ >= 0) {
-        model_.setPoint(dragIndex_, { (long double)w.x(), (long double)w.y() });
+        model_.setPoint(dragIndex_, { w.x(), w.y() });
         model_.computeDelaunay();
         emit triStatus((int)model_.size(), (int)model_.triangles().size());
         update();
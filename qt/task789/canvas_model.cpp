@@ -3,19 +3,19 @@
 #include <limits>
 
 namespace {
-long double dist2(const LDPoint& a, const QPointF& w) {
+long double dist2(const Point& a, const QPointF& w) {
     const long double dx = a.x - static_cast<long double>(w.x());
     const long double dy = a.y - static_cast<long double>(w.y());
     return dx*dx + dy*dy;
 }
 }
 
-LDPoly* CanvasModel::activePoints() {
+Poly* CanvasModel::activePoints() {
     if (phase_ == Phase::EditingA) return &ptsA_;
     if (phase_ == Phase::EditingB) return &ptsB_;
     return nullptr;
 }
-const LDPoly* CanvasModel::activePoints() const {
+const Poly* CanvasModel::activePoints() const {
     if (phase_ == Phase::EditingA) return &ptsA_;
     if (phase_ == Phase::EditingB) return &ptsB_;
     return nullptr;
@@ -45,7 +45,7 @@ void CanvasModel::finish() {
 int CanvasModel::addPoint(const QPointF& w) {
     auto* pts = activePoints();
     if (!pts) return -1;
-    pts->push_back(toLD(w));
+    pts->push_back(toPoint(w));
     recompute();
     return static_cast<int>(pts->size()) - 1;
 }
@@ -70,7 +70,7 @@ void CanvasModel::movePoint(int idx, const QPointF& w) {
     auto* pts = activePoints();
     if (!pts) return;
     if (idx < 0 || idx >= static_cast<int>(pts->size())) return;
-    (*pts)[idx] = toLD(w);
+    (*pts)[idx] = toPoint(w);
     recompute();
 }
 
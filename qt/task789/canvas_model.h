@@ -4,8 +4,8 @@
 
 #include <vector>
 
-using LDPoint = task789::Point;
-using LDPoly  = std::vector<LDPoint>;
+using Point = task789::Point;
+using Poly  = std::vector<Point>;
 
 enum class Phase {
     EditingA,
@@ -26,25 +26,25 @@ public:
     void movePoint(int idx, const QPointF& w);
     void deletePoint(int idx);
 
-    const LDPoly& pointsA() const { return ptsA_; }
-    const LDPoly& pointsB() const { return ptsB_; }
-    const LDPoly& hullA() const { return hullA_; }
-    const LDPoly& hullB() const { return hullB_; }
+    const Poly& pointsA() const { return ptsA_; }
+    const Poly& pointsB() const { return ptsB_; }
+    const Poly& hullA() const { return hullA_; }
+    const Poly& hullB() const { return hullB_; }
 
     void   setOpMode(OpMode m);
     OpMode opMode() const { return mode_; }
 
-    struct Result { std::vector<LDPoly> polys; };
+    struct Result { std::vector<Poly> polys; };
     const Result& result() const { return result_; }
 
     void recompute();
 
-    static QPointF toQt(const LDPoint& p) { return QPointF(static_cast<double>(p.x), static_cast<double>(p.y)); }
-    static LDPoint toLD(const QPointF& p) { return LDPoint{static_cast<long double>(p.x()), static_cast<long double>(p.y())}; }
+    static QPointF toQt(const Point& p) { return QPointF(p.x, p.y); }
+    static Point toPoint(const QPointF& p) { return Point{p.x(), p.y()}; }
 
 private:
-    LDPoly* activePoints();
-    const LDPoly* activePoints() const;
+    Poly* activePoints();
+    const Poly* activePoints() const;
 
     task789::Operation currentOperation() const;
 
@@ -52,10 +52,10 @@ private:
     Phase  phase_ = Phase::EditingA;
     OpMode mode_  = OpMode::Intersection;
 
-    LDPoly ptsA_;
-    LDPoly ptsB_;
-    LDPoly hullA_;
-    LDPoly hullB_;
+    Poly ptsA_;
+    Poly ptsB_;
+    Poly hullA_;
+    Poly hullB_;
 
     Result result_;
 };
@@ -154,14 +154,14 @@ void CanvasWidget::paintEvent(QPaintEvent *) {
     const double lineW   = 2.5 / viewScale_;
     const double radMark = 5.0 / viewScale_;
 
-    auto drawPoints = [&](const LDPoly& pts){
+    auto drawPoints = [&](const Poly& pts){
         p.setPen(QPen(Qt::black, lineW, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
         for (const auto& q : pts) {
             QPointF v((double)q.x, (double)q.y);
             p.drawEllipse(v, radMark, radMark);
         }
     };
-    auto drawPoly = [&](const LDPoly& poly, const QColor& col, double w){
+    auto drawPoly = [&](const Poly& poly, const QColor& col, double w){
         if (poly.size()<2) return;
         p.setPen(QPen(col, w / viewScale_, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
         for (int i=0;i<(int)poly.size();++i) {
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the algorithm tests: a failed CHECK reports itself and
+// marks the run failed; main() returns test_result().
+namespace test {
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline int test_result() {
+    if (failures() != 0) std::fprintf(stderr, "%d check(s) failed\n", failures());
+    return failures() == 0 ? 0 : 1;
+}
+}
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",               \
+                         __FILE__, __LINE__, #cond);                        \
+            ++test::failures();                                             \
+        }                                                                   \
+    } while (0)
@@ -0,0 +1,70 @@
+#include <task4/convex_hull.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "check.hpp"
+
+namespace {
+using task4::Point;
+
+std::vector<int> hull_of(const std::vector<Point>& pts, const task4::HullOptions& options) {
+    task4::HullIndices hull;
+    task4::convex_hull_indices(pts, &hull, options);
+    return hull;
+}
+
+// Every front end has to agree with the serial monotone chain.
+void check_all_paths(const std::vector<Point>& pts, const std::vector<int>& expected) {
+    task4::HullIndices hull;
+    CHECK(task4::convex_hull_indices(pts, &hull));
+    CHECK(hull == expected);
+
+    task4::HullOptions options;
+    options.radix = true;
+    CHECK(hull_of(pts, options) == expected);
+    options.radix = false;
+    options.algorithm = task4::HullAlgorithm::Chan;
+    CHECK(hull_of(pts, options) == expected);
+    options.algorithm = task4::HullAlgorithm::MonotoneChain;
+    options.threads = 3;
+    CHECK(hull_of(pts, options) == expected);
+
+    task4::StreamingHull stream;
+    stream.add(pts);
+    std::vector<int64_t> streamed;
+    CHECK(stream.hull(&streamed));
+    CHECK(std::vector<int>(streamed.begin(), streamed.end()) == expected);
+
+    task4::DynamicHull dynamic(pts);
+    task4::HullIndices dyn;
+    CHECK(dynamic.hull(&dyn));
+    CHECK(dyn == expected);
+}
+
+// A vertex one ulp right of the x = 1 side is a strict left turn and stays
+// on the hull.
+void one_ulp_vertex() {
+    const double x = std::nextafter(1.0, 2.0);
+    const std::vector<Point> pts = {{0.0, 0.0}, {1.0, 0.0}, {x, 0.5}, {1.0, 1.0}, {0.0, 1.0}};
+    check_all_paths(pts, {0, 1, 2, 3, 4});
+
+    const std::vector<Point> flat = {{0.0, 0.0}, {1.0, 0.0}, {1.0, 0.5}, {1.0, 1.0}, {0.0, 1.0}};
+    check_all_paths(flat, {0, 1, 3, 4});
+}
+
+// Points one ulp apart are distinct; exact repeats keep the lowest index.
+void near_duplicates() {
+    const double x = std::nextafter(2.0, 3.0);
+    const std::vector<Point> pts = {{0.0, 0.0}, {2.0, 0.0}, {x, 0.0}, {2.0, 2.0},
+                                    {2.0, 0.0}, {0.0, 2.0}, {0.0, 0.0}};
+    check_all_paths(pts, {0, 2, 3, 5});
+}
+}
+
+int main() {
+    one_ulp_vertex();
+    near_duplicates();
+    return test::test_result();
+}
@@ -0,0 +1,108 @@
+#include <task5/delaunay.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace {
+using task5::Point;
+using task5::Triangle;
+
+struct Summary {
+    std::set<std::array<int, 3>> triangles;
+    std::set<std::pair<int, int>> boundary;
+    std::set<int> vertices;
+};
+
+// Triangles up to rotation, the edges used once and the vertices used.
+Summary summarize(const std::vector<Triangle>& tris) {
+    Summary s;
+    std::map<std::pair<int, int>, int> edges;
+    for (const Triangle& T : tris) {
+        std::array<int, 3> v{T.a, T.b, T.c};
+        std::rotate(v.begin(), std::min_element(v.begin(), v.end()), v.end());
+        s.triangles.insert(v);
+        for (int i = 0; i < 3; ++i) {
+            const int a = v[i], b = v[(i + 1) % 3];
+            ++edges[{std::min(a, b), std::max(a, b)}];
+            s.vertices.insert(a);
+        }
+    }
+    for (const auto& e : edges) {
+        if (e.second == 1) s.boundary.insert(e.first);
+    }
+    return s;
+}
+
+// With cocircular points the two paths may pick different diagonals, so
+// only the hull, the vertex choice and the triangle count must agree;
+// otherwise the triangle sets are equal.
+void compare(const std::vector<Point>& pts, bool general_position) {
+    std::vector<Triangle> serial;
+    CHECK(task5::delaunay_triangulation(pts, &serial));
+    const Summary a = summarize(serial);
+    for (int threads : {2, 3}) {
+        task5::DelaunayOptions options;
+        options.threads = threads;
+        std::vector<Triangle> parallel;
+        CHECK(task5::delaunay_triangulation(pts, &parallel, nullptr, options));
+        const Summary b = summarize(parallel);
+        CHECK(parallel.size() == serial.size());
+        CHECK(b.boundary == a.boundary);
+        CHECK(b.vertices == a.vertices);
+        if (general_position) CHECK(b.triangles == a.triangles);
+    }
+}
+
+void uniform() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<Point> pts(40000);
+    for (Point& p : pts) p = Point{u(rng), u(rng)};
+    compare(pts, true);
+}
+
+// Integer grid with many repeats: the lowest index of each repeat is used.
+void grid_with_duplicates() {
+    std::mt19937 rng(11);
+    std::vector<Point> pts(40298);
+    for (Point& p : pts) {
+        p = Point{static_cast<double>(rng() % 3000), static_cast<double>(rng() % 3000)};
+    }
+    compare(pts, false);
+
+    std::set<std::pair<double, double>> seen;
+    std::vector<Triangle> tris;
+    task5::DelaunayOptions options;
+    options.threads = 2;
+    task5::delaunay_triangulation(pts, &tris, nullptr, options);
+    const Summary s = summarize(tris);
+    for (int i = 0; i < static_cast<int>(pts.size()); ++i) {
+        const bool first = seen.insert({pts[i].x, pts[i].y}).second;
+        if (!first) CHECK(s.vertices.count(i) == 0);
+    }
+}
+
+// Ten columns of points: the hull has thousands of collinear vertices and
+// the strip borders fall on shared x values.
+void collinear_hull() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<Point> pts(30000);
+    for (Point& p : pts) p = Point{static_cast<double>(rng() % 10), u(rng)};
+    compare(pts, true);
+}
+}
+
+int main() {
+    uniform();
+    grid_with_duplicates();
+    collinear_hull();
+    return test::test_result();
+}
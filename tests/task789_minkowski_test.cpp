@@ -0,0 +1,41 @@
+#include <task789/convex_boolean.hpp>
+
+#include "check.hpp"
+
+namespace {
+using task789::Polygon;
+
+// Same cyclic vertex sequence, from any start.
+bool same_outline(const Polygon& got, const Polygon& want) {
+    if (got.size() != want.size()) return false;
+    for (size_t s = 0; s < got.size(); ++s) {
+        bool all = true;
+        for (size_t k = 0; k < got.size() && all; ++k) {
+            const auto& p = got[(s + k) % got.size()];
+            all = p.x == want[k].x && p.y == want[k].y;
+        }
+        if (all) return true;
+    }
+    return false;
+}
+}
+
+int main() {
+    const Polygon unit = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    Polygon out;
+
+    // Parallel edges of A and B give one edge of the result.
+    CHECK(task789::minkowski_sum(unit, unit, &out));
+    CHECK(same_outline(out, {{0, 0}, {2, 0}, {2, 2}, {0, 2}}));
+    CHECK(task789::minkowski_difference(unit, unit, &out));
+    CHECK(same_outline(out, {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}}));
+
+    // B's edge (1 - 1e-30, 1) turns just left of A's (1, 1); the turn is
+    // lost when the difference is rounded, but the corner between them
+    // stays. The parallel top edges still merge.
+    const Polygon a = {{0, 0}, {1, 1}, {0, 1}};
+    const Polygon b = {{1e-30, 0}, {1, 1}, {0, 1}};
+    CHECK(task789::minkowski_sum(a, b, &out));
+    CHECK(same_outline(out, {{1e-30, 0}, {1, 1}, {2, 2}, {0, 2}, {0, 1}}));
+    return test::test_result();
+}
@@ -0,0 +1,54 @@
+#include <task789/convex_boolean.hpp>
+
+#include <vector>
+
+#include "check.hpp"
+
+namespace {
+using task789::Operation;
+using task789::Polygon;
+
+std::vector<Polygon> unite(const Polygon& a, const Polygon& b) {
+    return task789::boolean_operation(a, b, Operation::Union);
+}
+
+// Same cyclic vertex sequence, from any start.
+bool same_outline(const Polygon& got, const Polygon& want) {
+    if (got.size() != want.size()) return false;
+    for (size_t s = 0; s < got.size(); ++s) {
+        bool all = true;
+        for (size_t k = 0; k < got.size() && all; ++k) {
+            const auto& p = got[(s + k) % got.size()];
+            all = p.x == want[k].x && p.y == want[k].y;
+        }
+        if (all) return true;
+    }
+    return false;
+}
+
+void check_one(const Polygon& a, const Polygon& b, const Polygon& want) {
+    const std::vector<Polygon> r = unite(a, b);
+    CHECK(r.size() == 1);
+    if (r.size() == 1) CHECK(same_outline(r[0], want));
+}
+}
+
+int main() {
+    // boxes: overlapping squares with collinear top and bottom edges.
+    check_one({{0, 0}, {2, 0}, {2, 2}, {0, 2}}, {{1, 0}, {3, 0}, {3, 2}, {1, 2}},
+              {{0, 0}, {3, 0}, {3, 2}, {0, 2}});
+    // diamond: a square inscribed in a diamond, touching it at four points.
+    check_one({{1, -1}, {3, 1}, {1, 3}, {-1, 1}}, {{0, 0}, {2, 0}, {2, 2}, {0, 2}},
+              {{1, -1}, {3, 1}, {1, 3}, {-1, 1}});
+    // edge: squares sharing a whole edge give one rectangle.
+    check_one({{0, 0}, {1, 0}, {1, 1}, {0, 1}}, {{1, 0}, {2, 0}, {2, 1}, {1, 1}},
+              {{0, 0}, {2, 0}, {2, 1}, {0, 1}});
+    // Part of an edge shared: one outline with two reflex corners.
+    check_one({{0, 0}, {1, 0}, {1, 1}, {0, 1}}, {{1, 0.5}, {2, 0.5}, {2, 1.5}, {1, 1.5}},
+              {{0, 0}, {1, 0}, {1, 0.5}, {2, 0.5}, {2, 1.5}, {1, 1.5}, {1, 1}, {0, 1}});
+
+    // Touching at a corner, or apart: the two inputs.
+    CHECK(unite({{0, 0}, {1, 0}, {1, 1}, {0, 1}}, {{1, 1}, {2, 1}, {2, 2}, {1, 2}}).size() == 2);
+    CHECK(unite({{0, 0}, {1, 0}, {1, 1}, {0, 1}}, {{2, 0}, {3, 0}, {3, 1}, {2, 1}}).size() == 2);
+    return test::test_result();
+}